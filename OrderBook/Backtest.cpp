@@ -0,0 +1,74 @@
+#include "Backtest.h"
+
+#include <algorithm>
+#include <memory>
+
+#include "WorkStealingPool.h"
+
+/**
+ *  @brief Book and replay position of one job, touched by one task at a time
+ */
+struct BacktestState
+{
+    const BacktestJob& job;
+    BacktestResult&    result;
+    OrderBook          book;
+    Replayer           replayer;
+    const ReplayEvent* next;
+
+    BacktestState(const BacktestJob& job,
+                  BacktestResult&    result)
+        : job     ( job )
+        , result  ( result )
+        , book    ( [&result](Order order)
+                    {
+                        result.executions.push_back( BacktestResult::Execution{order.getId(), order.getType(),
+                                                                               order.getPrice(), order.getQuantity()} );
+                    } )
+        , replayer( book )
+        , next    ( job.begin )
+    {}
+};
+
+/**
+ *  @brief Replay one slice and resubmit the rest of the job
+ */
+static void replaySlice(WorkStealingPool& pool,
+                        BacktestState&    state,
+                        size_t            sliceSize)
+{
+    auto end = state.next + std::min<size_t>(state.job.end - state.next, sliceSize);
+    auto stats = state.replayer.replay(state.next, end);
+    state.result.events  += stats.events;
+    state.result.skipped += stats.skipped;
+    state.next = end;
+
+    if (state.next != state.job.end)
+        pool.submit([&pool, &state, sliceSize]() { replaySlice(pool, state, sliceSize); });
+    else
+        state.result.checksum = depthChecksum(state.book);
+}
+
+std::vector<BacktestResult> runBacktest(const std::vector<BacktestJob>& jobs,
+                                        size_t                          threadCount,
+                                        size_t                          sliceSize)
+{
+    sliceSize = std::max<size_t>(sliceSize, 1);
+    std::vector<BacktestResult> results( jobs.size() );
+    std::vector<std::unique_ptr<BacktestState>> states;
+    states.reserve( jobs.size() );
+    for (size_t i = 0; i < jobs.size(); ++i)
+    {
+        results[i].name = jobs[i].name;
+        states.push_back( std::unique_ptr<BacktestState>( new BacktestState(jobs[i], results[i]) ) );
+    }
+
+    WorkStealingPool pool(threadCount);
+    for (auto& state : states)
+    {
+        auto statePointer = state.get();
+        pool.submit([&pool, statePointer, sliceSize]() { replaySlice(pool, *statePointer, sliceSize); });
+    }
+    pool.wait();
+    return results;
+}
\ No newline at end of file
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "EventFile.h"
+#include "Replayer.h"
+
+/**
+ *  @brief Recorded order flow of one instrument
+ */
+struct BacktestJob
+{
+    std::string        name;
+    const ReplayEvent* begin;
+    const ReplayEvent* end;
+};
+
+/**
+ *  @brief Outcome of one instrument replay, equal for any number of threads
+ */
+struct BacktestResult
+{
+    struct Execution
+    {
+        Order::IdType       id;
+        Order::Type         type;
+        Order::PriceType    price;
+        Order::QuantityType quantity;
+    };
+
+    std::string            name;
+    uint64_t               events   = 0;
+    uint64_t               skipped  = 0;
+    uint64_t               checksum = 0;  ///< depthChecksum of the final book
+    std::vector<Execution> executions;    ///< Executed orders in callback order
+};
+
+/**
+ *  @brief Replay every job through its own order book on a work stealing pool
+ *
+ *  @param threadCount Number of threads, 0 means the number of hardware threads
+ *  @param sliceSize   Number of events a job replays before yielding to the others, so long histories do not
+ *                     delay short ones
+ *
+ *  @details Books share nothing, order IDs are sequential per book and slices of a job run one after another,
+ *           so results depend only on the jobs. Results are in the order of jobs
+ */
+std::vector<BacktestResult> runBacktest(const std::vector<BacktestJob>& jobs,
+                                        size_t                          threadCount = 0,
+                                        size_t                          sliceSize   = 65536);
\ No newline at end of file
@@ -0,0 +1,169 @@
+#include "DepthKernels.h"
+
+#ifdef DEPTH_KERNELS_X86
+#include <immintrin.h>
+#endif
+
+uint64_t DepthKernels::sumScalar(const Order::TotalQuantityType* quantities,
+                                 size_t                          count)
+{
+    uint64_t total = 0;
+    for (size_t i = 0; i < count; ++i)
+        total += quantities[i];
+    return total;
+}
+
+void DepthKernels::cumulativeFromBackScalar(const Order::TotalQuantityType* quantities,
+                                            size_t                          count,
+                                            uint64_t*                       out)
+{
+    uint64_t total = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        total += quantities[count - 1 - i];
+        out[i] = total;
+    }
+}
+
+#ifdef DEPTH_KERNELS_X86
+
+uint64_t DepthKernels::sumSse2(const Order::TotalQuantityType* quantities,
+                               size_t                          count)
+{
+    __m128i accumulator0 = _mm_setzero_si128();
+    __m128i accumulator1 = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        accumulator0 = _mm_add_epi64( accumulator0, _mm_loadu_si128( reinterpret_cast<const __m128i*>(quantities + i)     ) );
+        accumulator1 = _mm_add_epi64( accumulator1, _mm_loadu_si128( reinterpret_cast<const __m128i*>(quantities + i + 2) ) );
+    }
+    __m128i accumulator = _mm_add_epi64(accumulator0, accumulator1);
+    accumulator = _mm_add_epi64( accumulator, _mm_srli_si128(accumulator, 8) );
+    auto total = static_cast<uint64_t>( _mm_cvtsi128_si64(accumulator) );
+    return total + DepthKernels::sumScalar(quantities + i, count - i);
+}
+
+void DepthKernels::cumulativeFromBackSse2(const Order::TotalQuantityType* quantities,
+                                          size_t                          count,
+                                          uint64_t*                       out)
+{
+    __m128i carry = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2)
+    {
+        /// [q[count - 2 - i], q[count - 1 - i]] reversed to [q[count - 1 - i], q[count - 2 - i]]
+        __m128i x = _mm_loadu_si128( reinterpret_cast<const __m128i*>(quantities + count - 2 - i) );
+        x = _mm_shuffle_epi32( x, _MM_SHUFFLE(1, 0, 3, 2) );
+        x = _mm_add_epi64( x, _mm_slli_si128(x, 8) );
+        x = _mm_add_epi64(x, carry);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), x);
+        carry = _mm_shuffle_epi32( x, _MM_SHUFFLE(3, 2, 3, 2) );
+    }
+    if (i < count)
+        out[i] = static_cast<uint64_t>( _mm_cvtsi128_si64(carry) ) + quantities[0];
+}
+
+__attribute__((target("avx2")))
+uint64_t DepthKernels::sumAvx2(const Order::TotalQuantityType* quantities,
+                               size_t                          count)
+{
+    __m256i accumulator0 = _mm256_setzero_si256();
+    __m256i accumulator1 = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        accumulator0 = _mm256_add_epi64( accumulator0, _mm256_loadu_si256( reinterpret_cast<const __m256i*>(quantities + i)     ) );
+        accumulator1 = _mm256_add_epi64( accumulator1, _mm256_loadu_si256( reinterpret_cast<const __m256i*>(quantities + i + 4) ) );
+    }
+    accumulator0 = _mm256_add_epi64(accumulator0, accumulator1);
+    __m128i accumulator = _mm_add_epi64( _mm256_castsi256_si128(accumulator0),
+                                         _mm256_extracti128_si256(accumulator0, 1) );
+    accumulator = _mm_add_epi64( accumulator, _mm_srli_si128(accumulator, 8) );
+    auto total = static_cast<uint64_t>( _mm_cvtsi128_si64(accumulator) );
+    return total + DepthKernels::sumScalar(quantities + i, count - i);
+}
+
+__attribute__((target("avx2")))
+void DepthKernels::cumulativeFromBackAvx2(const Order::TotalQuantityType* quantities,
+                                          size_t                          count,
+                                          uint64_t*                       out)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i carry = zero;
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        __m256i loaded = _mm256_loadu_si256( reinterpret_cast<const __m256i*>(quantities + count - 4 - i) );
+        __m256i x = _mm256_permute4x64_epi64( loaded, _MM_SHUFFLE(0, 1, 2, 3) );
+
+        /// Inclusive scan over four lanes: shift by one lane, then by two lanes
+        x = _mm256_add_epi64( x, _mm256_blend_epi32( _mm256_permute4x64_epi64( x, _MM_SHUFFLE(2, 1, 0, 0) ), zero, 0x03 ) );
+        x = _mm256_add_epi64( x, _mm256_blend_epi32( _mm256_permute4x64_epi64( x, _MM_SHUFFLE(1, 0, 0, 0) ), zero, 0x0F ) );
+        x = _mm256_add_epi64(x, carry);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), x);
+        carry = _mm256_permute4x64_epi64( x, _MM_SHUFFLE(3, 3, 3, 3) );
+    }
+
+    auto total = static_cast<uint64_t>( _mm_cvtsi128_si64( _mm256_castsi256_si128(carry) ) );
+    for (; i < count; ++i)
+    {
+        total += quantities[count - 1 - i];
+        out[i] = total;
+    }
+}
+
+bool DepthKernels::isAvx2Supported()
+{
+    return __builtin_cpu_supports("avx2");
+}
+
+#endif  // DEPTH_KERNELS_X86
+
+namespace
+{
+    using SumFunction        = uint64_t (*)(const Order::TotalQuantityType*, size_t);
+    using CumulativeFunction = void     (*)(const Order::TotalQuantityType*, size_t, uint64_t*);
+
+    struct KernelSet
+    {
+        const char*        name;
+        SumFunction        sum;
+        CumulativeFunction cumulativeFromBack;
+    };
+
+    KernelSet selectKernels()
+    {
+#ifdef DEPTH_KERNELS_X86
+        if ( DepthKernels::isAvx2Supported() )
+            return { "avx2", DepthKernels::sumAvx2, DepthKernels::cumulativeFromBackAvx2 };
+        return { "sse2", DepthKernels::sumSse2, DepthKernels::cumulativeFromBackSse2 };
+#else
+        return { "scalar", DepthKernels::sumScalar, DepthKernels::cumulativeFromBackScalar };
+#endif
+    }
+
+    const KernelSet& kernels()
+    {
+        static const KernelSet kernelSet = selectKernels();
+        return kernelSet;
+    }
+}
+
+uint64_t DepthKernels::sum(const Order::TotalQuantityType* quantities,
+                           size_t                          count)
+{
+    return kernels().sum(quantities, count);
+}
+
+void DepthKernels::cumulativeFromBack(const Order::TotalQuantityType* quantities,
+                                      size_t                          count,
+                                      uint64_t*                       out)
+{
+    kernels().cumulativeFromBack(quantities, count, out);
+}
+
+const char* DepthKernels::instructionSet()
+{
+    return kernels().name;
+}
\ No newline at end of file
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "Order.h"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define DEPTH_KERNELS_X86
+#endif
+
+/**
+ *  @brief Vectorized kernels over price level quantities
+ *
+ *  @details Implementation is selected at runtime: AVX2 or SSE2 on x86-64, scalar code otherwise.
+ *           Level totals are 64-bit, so sums do not overflow for any realistic volume.
+ */
+class DepthKernels
+{
+public:
+    /**
+     *  @return Sum of count quantities
+     */
+    static uint64_t sum(const Order::TotalQuantityType* quantities,
+                        size_t                          count);
+
+    /**
+     *  @brief Cumulative sums starting from the last quantity: out[i] = quantities[count - 1] + ... + quantities[count - 1 - i]
+     *
+     *  @details Price levels keep the best level last, so out[i] is total quantity of i + 1 best levels
+     */
+    static void cumulativeFromBack(const Order::TotalQuantityType* quantities,
+                                   size_t                          count,
+                                   uint64_t*                       out);
+
+    /**
+     *  @return Name of the selected implementation: "avx2", "sse2" or "scalar"
+     */
+    static const char* instructionSet();
+
+    /**
+     *  @brief Reference implementations
+     */
+    static uint64_t sumScalar(const Order::TotalQuantityType* quantities,
+                              size_t                          count);
+    static void cumulativeFromBackScalar(const Order::TotalQuantityType* quantities,
+                                         size_t                          count,
+                                         uint64_t*                       out);
+
+#ifdef DEPTH_KERNELS_X86
+    /**
+     *  @brief Implementations of one instruction set, callable regardless of the selected one
+     *
+     *  @note AVX2 ones may be called only if isAvx2Supported()
+     */
+    static uint64_t sumSse2(const Order::TotalQuantityType* quantities,
+                            size_t                          count);
+    static void cumulativeFromBackSse2(const Order::TotalQuantityType* quantities,
+                                       size_t                          count,
+                                       uint64_t*                       out);
+    static uint64_t sumAvx2(const Order::TotalQuantityType* quantities,
+                            size_t                          count);
+    static void cumulativeFromBackAvx2(const Order::TotalQuantityType* quantities,
+                                       size_t                          count,
+                                       uint64_t*                       out);
+
+    static bool isAvx2Supported();
+#endif
+};
\ No newline at end of file
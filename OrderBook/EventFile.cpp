@@ -0,0 +1,207 @@
+#include "EventFile.h"
+
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include <sys/mman.h>
+
+static constexpr uint64_t EventFileMagic   = 0x4f424556454e5453;  // "OBEVENTS"
+static constexpr uint32_t EventFileVersion = 2;
+
+struct EventFileHeader
+{
+    uint64_t magic;
+    uint32_t version;
+    uint32_t eventSize;
+    uint64_t size;  ///< Number of events
+    uint64_t reserved;
+};
+
+static_assert(sizeof(EventFileHeader) % alignof(ReplayEvent) == 0, "Events follow the header");
+
+EventFile::EventFile(const std::string& path)
+    : _memory( SharedMemory::mapFile(path) )
+    , _events( nullptr )
+    , _size  ( 0 )
+{
+    const auto* header = static_cast<const EventFileHeader*>( _memory.data() );
+    if ( _memory.size() < sizeof(EventFileHeader) || header->magic != EventFileMagic ||
+         header->version != EventFileVersion || header->eventSize != sizeof(ReplayEvent) ||
+         (_memory.size() - sizeof(EventFileHeader)) / sizeof(ReplayEvent) < header->size )
+        throw std::runtime_error("Not an event file " + path);
+
+    _events = reinterpret_cast<const ReplayEvent*>(header + 1);
+    _size   = header->size;
+    madvise(_memory.data(), _memory.size(), MADV_SEQUENTIAL);  // Only a hint, failure is harmless
+}
+
+bool isValid(const ReplayEvent& event)
+{
+    switch (event.kind)
+    {
+        case ReplayEvent::Kind::Cancel:
+            return true;
+        case ReplayEvent::Kind::Add:
+            if (event.type != Order::Type::Bid && event.type != Order::Type::Ask)
+                return false;
+            break;
+        case ReplayEvent::Kind::Amend:
+            break;
+        default:
+            return false;
+    }
+    return event.price >= std::numeric_limits<Order::PriceType>::min() &&
+           event.price <= std::numeric_limits<Order::PriceType>::max();
+}
+
+EventFileWriter::EventFileWriter(const std::string& path)
+    : _file( path, std::ios::binary | std::ios::trunc )
+    , _size( 0 )
+{
+    if (not _file)
+        throw std::runtime_error("Cannot create event file " + path);
+    EventFileHeader header{};
+    _file.write( reinterpret_cast<const char*>(&header), sizeof(header) );
+}
+
+EventFileWriter::~EventFileWriter()
+{
+    close();
+}
+
+void EventFileWriter::write(const ReplayEvent& event)
+{
+    _file.write( reinterpret_cast<const char*>(&event), sizeof(event) );
+    ++_size;
+}
+
+void EventFileWriter::close()
+{
+    if ( not _file.is_open() )
+        return;
+
+    EventFileHeader header{EventFileMagic, EventFileVersion, sizeof(ReplayEvent), _size, 0};
+    _file.seekp(0);
+    _file.write( reinterpret_cast<const char*>(&header), sizeof(header) );
+    _file.close();
+}
+
+static std::runtime_error csvError(uint64_t           lineNumber,
+                                   const std::string& message)
+{
+    return std::runtime_error( "line " + std::to_string(lineNumber) + ": " + message );
+}
+
+static uint64_t parseNumber(const std::string& field,
+                            uint64_t           lineNumber)
+{
+    size_t parsed = 0;
+    uint64_t value = 0;
+    try
+    {
+        /// stoull accepts and negates a minus sign
+        if ( field.find('-') == std::string::npos )
+            value = std::stoull(field, &parsed);
+    }
+    catch (const std::out_of_range&)
+    {
+        throw csvError(lineNumber, "number out of range '" + field + "'");
+    }
+    catch (const std::exception&)
+    {
+        parsed = 0;
+    }
+    if ( parsed == 0 || parsed != field.size() )
+        throw csvError(lineNumber, "invalid number '" + field + "'");
+    return value;
+}
+
+static Order::PriceType parsePrice(const std::string& field,
+                                   uint64_t           lineNumber)
+{
+    size_t parsed = 0;
+    long long value = 0;
+    try
+    {
+        value = std::stoll(field, &parsed);
+    }
+    catch (const std::out_of_range&)
+    {
+        throw csvError(lineNumber, "price out of range '" + field + "'");
+    }
+    catch (const std::exception&)
+    {
+        parsed = 0;
+    }
+    if ( parsed == 0 || parsed != field.size() )
+        throw csvError(lineNumber, "invalid price '" + field + "'");
+    if ( value < std::numeric_limits<Order::PriceType>::min() || value > std::numeric_limits<Order::PriceType>::max() )
+        throw csvError(lineNumber, "price out of range '" + field + "'");
+    return static_cast<Order::PriceType>(value);
+}
+
+static Order::QuantityType parseQuantity(const std::string& field,
+                                         uint64_t           lineNumber)
+{
+    auto value = parseNumber(field, lineNumber);
+    if ( value > std::numeric_limits<Order::QuantityType>::max() )
+        throw csvError(lineNumber, "quantity out of range '" + field + "'");
+    return static_cast<Order::QuantityType>(value);
+}
+
+uint64_t convertCsv(std::istream&    input,
+                    EventFileWriter& writer)
+{
+    uint64_t converted  = 0;
+    uint64_t lineNumber = 0;
+    std::string line;
+    std::vector<std::string> fields;
+    while ( std::getline(input, line) )
+    {
+        ++lineNumber;
+        if ( not line.empty() && line.back() == '\r' )
+            line.pop_back();
+        if ( line.empty() || line[0] == '#' )
+            continue;
+
+        fields.clear();
+        std::istringstream lineStream(line);
+        std::string field;
+        while ( std::getline(lineStream, field, ',') )
+            fields.push_back(field);
+
+        if (fields.size() < 3)
+            throw csvError(lineNumber, "expected at least timestamp, action and id");
+        ReplayEvent event{};
+        event.timestamp = parseNumber(fields[0], lineNumber);
+        event.id        = parseNumber(fields[2], lineNumber);
+
+        if (fields[1] == "C")
+            event.kind = ReplayEvent::Kind::Cancel;
+        else if (fields[1] == "A" || fields[1] == "M")
+        {
+            if (fields.size() != 6)
+                throw csvError(lineNumber, "expected timestamp,action,id,side,price,quantity");
+            event.kind     = fields[1] == "A" ? ReplayEvent::Kind::Add : ReplayEvent::Kind::Amend;
+            event.price    = parsePrice(fields[4], lineNumber);
+            event.quantity = parseQuantity(fields[5], lineNumber);
+            if (event.kind == ReplayEvent::Kind::Add)
+            {
+                if (fields[3] == "B")
+                    event.type = Order::Type::Bid;
+                else if (fields[3] == "S")
+                    event.type = Order::Type::Ask;
+                else
+                    throw csvError(lineNumber, "invalid side '" + fields[3] + "'");
+            }
+        }
+        else
+            throw csvError(lineNumber, "invalid action '" + fields[1] + "'");
+
+        writer.write(event);
+        ++converted;
+    }
+    return converted;
+}
\ No newline at end of file
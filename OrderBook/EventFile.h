@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <istream>
+#include <string>
+
+#include "Order.h"
+#include "SharedMemory.h"
+
+/**
+ *  @brief Recorded order flow event, the file keeps events in host byte order
+ */
+struct ReplayEvent
+{
+    enum class Kind : uint8_t
+    {
+        Add,
+        Cancel,
+        Amend
+    };
+
+    uint64_t            timestamp;  ///< Nanoseconds
+    uint64_t            id;         ///< Original order ID
+    int64_t             price;      ///< Add and Amend, 64 bits wide in any build so files are portable
+    Order::QuantityType quantity;   ///< Add and Amend
+    Kind                kind;
+    Order::Type         type;       ///< Add
+    uint8_t             reserved[2];
+};
+
+static_assert(sizeof(ReplayEvent) == 32, "Event file layout");
+
+/**
+ *  @return false in case kind or side is not one of the enumerators or price does not fit Order::PriceType
+ *
+ *  @details Event files are mapped as they are, so events of a damaged or foreign file are checked before use
+ */
+bool isValid(const ReplayEvent& event);
+
+/**
+ *  @brief Memory mapped event file, events are read in place without copying
+ *
+ *  @throws std::runtime_error Thrown in case the file is not an event file
+ */
+class EventFile
+{
+public:
+    explicit EventFile(const std::string& path);
+
+    [[nodiscard]] const ReplayEvent* begin() const { return _events; }
+    [[nodiscard]] const ReplayEvent* end  () const { return _events + _size; }
+    [[nodiscard]] size_t             size () const { return _size; }
+
+private:
+    SharedMemory       _memory;
+    const ReplayEvent* _events;
+    size_t             _size;
+};
+
+/**
+ *  @brief Writer of event files, the header is completed by close() or destructor
+ */
+class EventFileWriter
+{
+public:
+    explicit EventFileWriter(const std::string& path);
+    ~EventFileWriter();
+
+    void write(const ReplayEvent& event);
+
+    void close();
+
+    [[nodiscard]] uint64_t getSize() const { return _size; }
+
+private:
+    std::ofstream _file;
+    uint64_t      _size;
+};
+
+/**
+ *  @brief Convert CSV lines "timestamp,action,id,side,price,quantity" into events
+ *
+ *  @details Action is A (add), C (cancel) or M (amend), side is B or S and is used by add only.
+ *           Cancel needs timestamp, action and id only. Empty lines and lines starting with '#' are skipped.
+ *
+ *  @throws std::runtime_error Thrown with the line number in case the line cannot be parsed,
+ *                            a number is negative or a value does not fit its event field
+ *
+ *  @return Number of converted events
+ */
+uint64_t convertCsv(std::istream&    input,
+                    EventFileWriter& writer);
\ No newline at end of file
@@ -0,0 +1,259 @@
+#include "MarketDataRing.h"
+
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "Shared memory ring requires lock-free 64-bit atomics");
+
+static constexpr uint64_t RingMagic = 0x4f424d4452494e32;  // "OBMDRIN2", level totals are 64-bit
+
+/**
+ *  @brief Layout of the shared memory object: header, ask and bid snapshot levels, event slots
+ */
+struct RingHeader
+{
+    std::atomic<uint64_t> magic;  ///< Written the last by the publisher
+    uint32_t              capacity;
+    uint32_t              depth;
+
+    alignas(64) std::atomic<uint64_t> published;  ///< Sequence of the last written event
+
+    alignas(64) std::atomic<uint64_t> snapshotVersion;  ///< Odd while the snapshot is written
+    uint64_t                          snapshotSequence;
+    uint32_t                          askCount;
+    uint32_t                          bidCount;
+    bool                              haveTransactionsStarted;
+    OrderBook::PricePosition          lastTransaction;
+};
+
+struct RingSlot
+{
+    std::atomic<uint64_t>    sequence;  ///< Zero while the slot is written
+    MarketDataEvent::Kind    kind;
+    Order::Type              side;
+    Order::PriceType         price;
+    Order::TotalQuantityType quantity;
+};
+
+static size_t ringSize(uint32_t capacity,
+                       uint32_t depth)
+{
+    return sizeof(RingHeader) + 2 * depth * sizeof(OrderBook::PricePosition) + capacity * sizeof(RingSlot);
+}
+
+static RingHeader& header(const SharedMemory& memory)
+{
+    return *static_cast<RingHeader*>( memory.data() );
+}
+
+static OrderBook::PricePosition* snapshotLevels(const SharedMemory& memory,
+                                                Order::Type         side)
+{
+    auto levels = reinterpret_cast<OrderBook::PricePosition*>(&header(memory) + 1);
+    return side == Order::Type::Ask ? levels : levels + header(memory).depth;
+}
+
+static RingSlot* slots(const SharedMemory& memory)
+{
+    return reinterpret_cast<RingSlot*>( snapshotLevels(memory, Order::Type::Bid) + header(memory).depth );
+}
+
+static uint32_t roundUpToPowerOfTwo(uint32_t value)
+{
+    uint32_t result = 1;
+    while (result < value)
+        result <<= 1;
+    return result;
+}
+
+MarketDataPublisher::MarketDataPublisher(const std::string& name,
+                                         uint32_t           capacity,
+                                         uint32_t           depth,
+                                         uint32_t           snapshotInterval)
+    : _memory          ( SharedMemory::create( name, ringSize(roundUpToPowerOfTwo(capacity), depth) ) )
+    , _capacity        ( roundUpToPowerOfTwo(capacity) )
+    , _depth           ( depth )
+    , _snapshotInterval( std::max<uint32_t>(snapshotInterval, 1) )
+    , _publications    ( 0 )
+    , _sequence        ( 0 )
+    , _tradeCount      ( 0 )
+    , _lastTransaction ( false, OrderBook::PricePosition() )
+{
+    /// Zero filled memory is valid initial state of atomics, slots and the empty snapshot
+    auto& ringHeader = header(_memory);
+    ringHeader.capacity = _capacity;
+    ringHeader.depth    = _depth;
+    ringHeader.magic.store(RingMagic, std::memory_order_release);
+}
+
+void MarketDataPublisher::write(MarketDataEvent::Kind    kind,
+                                Order::Type              side,
+                                Order::PriceType         price,
+                                Order::TotalQuantityType quantity)
+{
+    auto& slot = slots(_memory)[++_sequence & (_capacity - 1)];
+    slot.sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.kind     = kind;
+    slot.side     = side;
+    slot.price    = price;
+    slot.quantity = quantity;
+    slot.sequence.store(_sequence, std::memory_order_release);
+    header(_memory).published.store(_sequence, std::memory_order_release);
+}
+
+void MarketDataPublisher::publishSide(Order::Type                            side,
+                                      std::vector<OrderBook::PricePosition>& published)
+{
+    auto isBetter = [side](Order::PriceType p1, Order::PriceType p2)
+    {
+        return side == Order::Type::Bid ? p1 > p2 : p1 < p2;
+    };
+
+    /// L1 goes first so that top of book consumers may skip the rest
+    bool wasEmpty = published.empty();
+    bool isEmpty  = _levels.empty();
+    if ( wasEmpty != isEmpty ||
+         ( not isEmpty && ( published[0].price    != _levels[0].price ||
+                            published[0].quantity != _levels[0].quantity ) ) )
+    {
+        if (isEmpty)
+            write(MarketDataEvent::Kind::BestPrice, side, 0, 0);
+        else
+            write(MarketDataEvent::Kind::BestPrice, side, _levels[0].price, _levels[0].quantity);
+    }
+
+    /// Both sequences are sorted from the best price
+    size_t i = 0;
+    size_t j = 0;
+    while ( i < published.size() || j < _levels.size() )
+    {
+        if ( j == _levels.size() ||
+             ( i < published.size() && isBetter(published[i].price, _levels[j].price) ) )
+        {
+            write(MarketDataEvent::Kind::Level, side, published[i].price, 0);
+            ++i;
+        }
+        else if ( i == published.size() || isBetter(_levels[j].price, published[i].price) )
+        {
+            write(MarketDataEvent::Kind::Level, side, _levels[j].price, _levels[j].quantity);
+            ++j;
+        }
+        else
+        {
+            if (published[i].quantity != _levels[j].quantity)
+                write(MarketDataEvent::Kind::Level, side, _levels[j].price, _levels[j].quantity);
+            ++i;
+            ++j;
+        }
+    }
+    published.swap(_levels);
+}
+
+void MarketDataPublisher::publish(const OrderBook& book)
+{
+    book.getPriceLevels(Order::Type::Ask, static_cast<int>(_depth), _levels);
+    publishSide(Order::Type::Ask, _asks);
+    book.getPriceLevels(Order::Type::Bid, static_cast<int>(_depth), _levels);
+    publishSide(Order::Type::Bid, _bids);
+
+    /// Trade count distinguishes equal consecutive transactions
+    auto lastTransaction = book.getLastTransaction();
+    auto tradeCount = book.getTradeStatistics().tradeCount;
+    if ( lastTransaction.first &&
+         ( tradeCount != _tradeCount || not _lastTransaction.first ||
+           lastTransaction.second.price    != _lastTransaction.second.price ||
+           lastTransaction.second.quantity != _lastTransaction.second.quantity ) )
+        write(MarketDataEvent::Kind::LastTransaction, Order::Type::Bid,
+              lastTransaction.second.price, lastTransaction.second.quantity);
+    _lastTransaction = lastTransaction;
+    _tradeCount      = tradeCount;
+
+    if (++_publications >= _snapshotInterval)
+        writeSnapshot();
+}
+
+void MarketDataPublisher::writeSnapshot()
+{
+    _publications = 0;
+    auto& ringHeader = header(_memory);
+    auto version = ringHeader.snapshotVersion.load(std::memory_order_relaxed);
+    ringHeader.snapshotVersion.store(version + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    ringHeader.snapshotSequence = _sequence;
+    ringHeader.askCount = static_cast<uint32_t>( _asks.size() );
+    ringHeader.bidCount = static_cast<uint32_t>( _bids.size() );
+    std::copy( _asks.begin(), _asks.end(), snapshotLevels(_memory, Order::Type::Ask) );
+    std::copy( _bids.begin(), _bids.end(), snapshotLevels(_memory, Order::Type::Bid) );
+    ringHeader.haveTransactionsStarted = _lastTransaction.first;
+    ringHeader.lastTransaction         = _lastTransaction.second;
+
+    ringHeader.snapshotVersion.store(version + 2, std::memory_order_release);
+}
+
+MarketDataReader::MarketDataReader(const std::string& name)
+    : _memory( SharedMemory::open(name) )
+    , _next  ( 1 )
+{
+    if ( _memory.size() < sizeof(RingHeader) ||
+         header(_memory).magic.load(std::memory_order_acquire) != RingMagic ||
+         _memory.size() < ringSize( header(_memory).capacity, header(_memory).depth ) )
+        throw std::runtime_error("Not a market data ring " + name);
+}
+
+MarketDataReader::PollStatus MarketDataReader::poll(MarketDataEvent& event)
+{
+    const auto& ringHeader = header(_memory);
+    auto published = ringHeader.published.load(std::memory_order_acquire);
+    if (_next > published)
+        return PollStatus::Empty;
+    if (published - _next >= ringHeader.capacity)
+        return PollStatus::Overrun;
+
+    /// The slot is valid in case its sequence did not change while it was copied
+    const auto& slot = slots(_memory)[_next & (ringHeader.capacity - 1)];
+    if (slot.sequence.load(std::memory_order_acquire) != _next)
+        return PollStatus::Overrun;
+    event.sequence = _next;
+    event.kind     = slot.kind;
+    event.side     = slot.side;
+    event.price    = slot.price;
+    event.quantity = slot.quantity;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.sequence.load(std::memory_order_relaxed) != _next)
+        return PollStatus::Overrun;
+
+    ++_next;
+    return PollStatus::Event;
+}
+
+bool MarketDataReader::readSnapshot(MarketDataSnapshot& snapshot,
+                                    int                 attempts)
+{
+    const auto& ringHeader = header(_memory);
+    while (attempts-- > 0)
+    {
+        auto version = ringHeader.snapshotVersion.load(std::memory_order_acquire);
+        if (version % 2 != 0)
+            continue;
+
+        /// Counts are clamped since they may be torn by the concurrent refresh
+        snapshot.sequence = ringHeader.snapshotSequence;
+        auto askLevels = snapshotLevels(_memory, Order::Type::Ask);
+        auto bidLevels = snapshotLevels(_memory, Order::Type::Bid);
+        snapshot.asks.assign( askLevels, askLevels + std::min(ringHeader.askCount, ringHeader.depth) );
+        snapshot.bids.assign( bidLevels, bidLevels + std::min(ringHeader.bidCount, ringHeader.depth) );
+        snapshot.haveTransactionsStarted = ringHeader.haveTransactionsStarted;
+        snapshot.lastTransaction         = ringHeader.lastTransaction;
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (ringHeader.snapshotVersion.load(std::memory_order_relaxed) == version)
+        {
+            _next = snapshot.sequence + 1;
+            return true;
+        }
+    }
+    return false;
+}
\ No newline at end of file
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "OrderBook.h"
+#include "SharedMemory.h"
+
+/**
+ *  @brief Market data event published to the shared memory ring
+ */
+struct MarketDataEvent
+{
+    enum class Kind : uint8_t
+    {
+        BestPrice,        ///< Best price level of side changed, zero quantity means the side is empty
+        Level,            ///< Price level within the published depth changed, zero quantity means the level is gone
+        LastTransaction   ///< Last transaction as in L1 market data
+    };
+
+    uint64_t                 sequence = 0;
+    Kind                     kind     = Kind::Level;
+    Order::Type              side     = Order::Type::Bid;  ///< Not used by LastTransaction
+    Order::PriceType         price    = 0;
+    Order::TotalQuantityType quantity = 0;
+};
+
+/**
+ *  @brief Consistent copy of the published depth
+ */
+struct MarketDataSnapshot
+{
+    uint64_t                              sequence = 0;  ///< Events up to the sequence are reflected
+    std::vector<OrderBook::PricePosition> bids;          ///< The best level is the first one
+    std::vector<OrderBook::PricePosition> asks;
+    bool                                  haveTransactionsStarted = false;
+    OrderBook::PricePosition              lastTransaction;
+};
+
+/**
+ *  @brief Single writer of market data events into a shared memory ring read by local processes
+ *
+ *  @details publish() compares the book with the previously published state and writes only changed
+ *           levels within the published depth, so it is called once per processed command or batch.
+ *           Events overwrite the oldest ones, the snapshot region is refreshed every snapshotInterval
+ *           publications to let overrun readers resync. Readers never make system calls after opening.
+ */
+class MarketDataPublisher
+{
+public:
+    /**
+     *  @param name             Shared memory object name starting with '/'
+     *  @param capacity         Number of events in the ring, rounded up to a power of two
+     *  @param depth            Number of price levels per side published
+     *  @param snapshotInterval Number of publications between snapshot refreshes
+     */
+    MarketDataPublisher(const std::string& name,
+                        uint32_t           capacity,
+                        uint32_t           depth,
+                        uint32_t           snapshotInterval = 1);
+
+    /**
+     *  @brief Publish changes of the book since the previous call
+     */
+    void publish(const OrderBook& book);
+
+    [[nodiscard]] uint64_t getSequence() const { return _sequence; }
+
+private:
+    SharedMemory _memory;
+    uint32_t     _capacity;
+    uint32_t     _depth;
+    uint32_t     _snapshotInterval;
+    uint32_t     _publications;  ///< Since the last snapshot refresh
+    uint64_t     _sequence;      ///< Sequence of the last written event
+
+    std::vector<OrderBook::PricePosition>     _bids;    ///< Published state
+    std::vector<OrderBook::PricePosition>     _asks;
+    std::vector<OrderBook::PricePosition>     _levels;  ///< Current state of a side, capacity is reused
+    uint64_t                                  _tradeCount;
+    std::pair<bool, OrderBook::PricePosition> _lastTransaction;
+
+    void write(MarketDataEvent::Kind    kind,
+               Order::Type              side,
+               Order::PriceType         price,
+               Order::TotalQuantityType quantity);
+
+    /**
+     *  @brief Write events of one side and make current levels the published ones
+     */
+    void publishSide(Order::Type                            side,
+                     std::vector<OrderBook::PricePosition>& published);
+
+    void writeSnapshot();
+};
+
+/**
+ *  @brief Reader of the market data ring, any number of readers may open the same ring
+ */
+class MarketDataReader
+{
+public:
+    enum class PollStatus : uint8_t
+    {
+        Event,    ///< The next event is read
+        Empty,    ///< No new events
+        Overrun   ///< Events were overwritten before they were read, resync by readSnapshot()
+    };
+
+    /**
+     *  @details Reading starts from the first event, call readSnapshot() to start from the current state
+     */
+    explicit MarketDataReader(const std::string& name);
+
+    PollStatus poll(MarketDataEvent& event);
+
+    /**
+     *  @brief Copy the snapshot and continue polling with the first event after it
+     *
+     *  @return false in case the writer kept refreshing the snapshot during all attempts
+     */
+    bool readSnapshot(MarketDataSnapshot& snapshot,
+                      int                 attempts = 1000);
+
+private:
+    SharedMemory _memory;
+    uint64_t     _next;  ///< Sequence of the next event to read
+};
\ No newline at end of file
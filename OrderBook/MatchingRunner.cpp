@@ -0,0 +1,183 @@
+#include "MatchingRunner.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <future>
+#include <new>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+constexpr int MatchingRunner::NoCpu;
+
+static uint32_t roundUpToPowerOfTwo(uint32_t value)
+{
+    uint32_t result = 1;
+    while (result < value)
+        result *= 2;
+    return result;
+}
+
+/**
+ *  @brief Spin-wait hint, lets the sibling hyper-thread run and saves power on empty polls
+ */
+static void cpuRelax()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    _mm_pause();
+#endif
+}
+
+/**
+ *  @return true if the calling thread is pinned to cpu
+ */
+static bool pinCurrentThread(int cpu)
+{
+#ifdef __linux__
+    if (cpu != MatchingRunner::NoCpu)
+    {
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        CPU_SET(cpu, &cpus);
+        return pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus) == 0;
+    }
+#endif
+    return false;
+}
+
+void MatchingRunner::FreeMemory::operator()(void* memory) const
+{
+    std::free(memory);
+}
+
+void* MatchingRunner::allocateQueue(uint32_t capacity)
+{
+    /// Queue indices are cache line aligned, zero filled memory is the empty queue
+    void* memory = nullptr;
+    auto size = SharedQueue<MatchingCommand>::memorySize(capacity);
+    if (posix_memalign(&memory, 64, size) != 0)
+        throw std::bad_alloc();
+    std::memset(memory, 0, size);
+    return memory;
+}
+
+MatchingRunner::MatchingRunner(const Options&                options,
+                               CompletedCallback             completedCallback,
+                               OrderBook::OrderCallback      executedOrderCallback,
+                               OrderBook::OrderCallback      canceledOrderCallback,
+                               OrderBook::OrderBatchCallback canceledBatchCallback)
+    : _options          ( options )
+    , _completedCallback( std::move(completedCallback) )
+    , _orderBook        ( std::move(executedOrderCallback), std::move(canceledOrderCallback),
+                          std::move(canceledBatchCallback), options.arena )
+    , _queueMemory      ( allocateQueue( roundUpToPowerOfTwo(options.capacity) ) )
+    , _producerQueue    ( _queueMemory.get(), roundUpToPowerOfTwo(options.capacity) )
+    , _consumerQueue    ( _queueMemory.get(), roundUpToPowerOfTwo(options.capacity) )
+    , _isStopping       ( false )
+    , _isPinned         ( false )
+    , _busyNanoseconds  ( 0 )
+    , _idleNanoseconds  ( 0 )
+    , _commands         ( 0 )
+{
+    /// The thread pins itself before the first poll, the runner is returned once the result is known
+    std::promise<bool> pinned;
+    auto isPinned = pinned.get_future();
+    _thread = std::thread([this](std::promise<bool> result) { run(result); }, std::move(pinned));
+    _isPinned = isPinned.get();
+}
+
+MatchingRunner::~MatchingRunner()
+{
+    stop();
+}
+
+void MatchingRunner::stop()
+{
+    _isStopping.store(true, std::memory_order_release);
+    if (_thread.joinable())
+        _thread.join();
+}
+
+MatchingRunner::Utilization MatchingRunner::getUtilization() const
+{
+    Utilization utilization;
+    utilization.busyNanoseconds = _busyNanoseconds.load(std::memory_order_relaxed);
+    utilization.idleNanoseconds = _idleNanoseconds.load(std::memory_order_relaxed);
+    utilization.commands        = _commands       .load(std::memory_order_relaxed);
+    return utilization;
+}
+
+void MatchingRunner::run(std::promise<bool>& pinned)
+{
+    using Clock = std::chrono::steady_clock;
+
+    pinned.set_value( pinCurrentThread(_options.cpu) );
+
+    MatchingCommand command;
+    uint32_t emptyPolls = 0;
+    auto last = Clock::now();
+    while (true)
+    {
+        /// Stop flag is read before the poll, so commands submitted before stop() are seen by the poll
+        bool isStopping = _isStopping.load(std::memory_order_acquire);
+        uint64_t processed = 0;
+        while ( _consumerQueue.tryPop(command) )
+        {
+            process(command);
+            ++processed;
+        }
+
+        /// One clock read per poll: the time since the previous one is busy in case the poll had commands
+        auto now = Clock::now();
+        auto elapsed = static_cast<uint64_t>( std::chrono::duration_cast<std::chrono::nanoseconds>(now - last).count() );
+        last = now;
+        if (processed > 0)
+        {
+            _busyNanoseconds.fetch_add(elapsed,   std::memory_order_relaxed);
+            _commands       .fetch_add(processed, std::memory_order_relaxed);
+            emptyPolls = 0;
+            continue;
+        }
+        _idleNanoseconds.fetch_add(elapsed, std::memory_order_relaxed);
+
+        if (isStopping)
+            return;
+        if (_options.backoffPolls != 0 && ++emptyPolls >= _options.backoffPolls)
+        {
+            emptyPolls = _options.backoffPolls;
+            std::this_thread::yield();
+        }
+        else
+            cpuRelax();
+    }
+}
+
+void MatchingRunner::process(const MatchingCommand& command)
+{
+    Order::IdType id = command.id;
+    bool isApplied = true;
+    switch (command.kind)
+    {
+        case MatchingCommand::Kind::Add:
+            id = _orderBook.addOrder(command.type, command.price, command.quantity, command.owner);
+            break;
+        case MatchingCommand::Kind::Cancel:
+            isApplied = command.id != 0 && _orderBook.tryCancelOrder(command.id) == OrderBook::CancelStatus::Canceled;
+            break;
+        case MatchingCommand::Kind::Amend:
+            isApplied = command.id != 0 && _orderBook.findOrderById(command.id).first;
+            if (isApplied)
+                _orderBook.amendOrder(command.id, command.price, command.quantity);
+            break;
+    }
+
+    if (_completedCallback)
+        _completedCallback(command, id, isApplied);
+}
\ No newline at end of file
@@ -0,0 +1,156 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <thread>
+
+#include "MemoryArena.h"
+#include "OrderBook.h"
+#include "SharedQueue.h"
+
+/**
+ *  @brief Fixed size command applied to the order book by the runner thread
+ */
+struct MatchingCommand
+{
+    enum class Kind : uint8_t
+    {
+        Add,
+        Cancel,
+        Amend
+    };
+
+    uint64_t            tag      = 0;  ///< Chosen by producer, passed back with the completion
+    Order::IdType       id       = 0;  ///< Cancel and Amend, 0 is not applied
+    Kind                kind     = Kind::Add;
+    Order::Type         type     = Order::Type::Bid;  ///< Add
+    Order::PriceType    price    = 0;  ///< Add and Amend
+    Order::QuantityType quantity = 0;  ///< Add and Amend
+    Order::OwnerType    owner    = Order::NoOwner;  ///< Add
+};
+
+/**
+ *  @brief Dedicated thread which owns an order book and busy-polls its command queue
+ *
+ *  @details The thread is pinned to the configured CPU and never blocks while commands may arrive, so
+ *           matching latency does not include wakeups or migrations. Empty polls pause the core and may
+ *           back off by yielding after a number of them, to share a core with other threads in tests
+ *           or on small machines. Callbacks are called on the runner thread.
+ */
+class MatchingRunner
+{
+public:
+    static constexpr int NoCpu = -1;
+
+    /**
+     *  @brief Callback type of processed commands
+     *
+     *  @details id is the order ID, assigned by the book for Add. isApplied is false in case
+     *           the order of Cancel or Amend is not in the book
+     */
+    using CompletedCallback = std::function<void (const MatchingCommand& command, Order::IdType id, bool isApplied)>;
+
+    struct Options
+    {
+        int          cpu          = NoCpu;    ///< CPU to pin the thread to, NoCpu leaves it to the scheduler
+        uint32_t     capacity     = 65536;    ///< Command queue capacity, rounded up to a power of two
+        uint32_t     backoffPolls = 0;        ///< Empty polls before yielding, 0 means pure busy polling
+        MemoryArena* arena        = nullptr;  ///< Storage of the book, e.g. on the NUMA node of the CPU
+    };
+
+    /**
+     *  @brief Busy and idle time of the runner thread
+     */
+    struct Utilization
+    {
+        uint64_t busyNanoseconds = 0;
+        uint64_t idleNanoseconds = 0;
+        uint64_t commands        = 0;
+
+        [[nodiscard]] double busyFraction() const
+        {
+            auto total = busyNanoseconds + idleNanoseconds;
+            return total == 0 ? 0.0 : static_cast<double>(busyNanoseconds) / total;
+        }
+    };
+
+    /**
+     *  @brief Start the runner thread and wait until it pins itself to the configured CPU
+     *
+     *  @see OrderBook::OrderBook
+     */
+    MatchingRunner(const Options&                options,
+                   CompletedCallback             completedCallback     = nullptr,
+                   OrderBook::OrderCallback      executedOrderCallback = nullptr,
+                   OrderBook::OrderCallback      canceledOrderCallback = nullptr,
+                   OrderBook::OrderBatchCallback canceledBatchCallback = nullptr);
+
+    /**
+     *  @brief Stop the thread after it processes the submitted commands
+     */
+    ~MatchingRunner();
+
+    MatchingRunner(const MatchingRunner&)            = delete;
+    MatchingRunner& operator=(const MatchingRunner&) = delete;
+
+    /**
+     *  @return false in case the queue is full
+     *
+     *  @note Single producer: commands are submitted from one thread at a time
+     */
+    bool trySubmit(const MatchingCommand& command) { return _producerQueue.tryPush(command); }
+
+    /**
+     *  @brief Process the submitted commands and stop the thread, the runner does not start again
+     */
+    void stop();
+
+    /**
+     *  @return true if the thread is pinned to the configured CPU
+     */
+    [[nodiscard]] bool isPinned() const { return _isPinned; }
+
+    /**
+     *  @brief Snapshot of counters updated by the runner thread, may be called from any thread
+     */
+    [[nodiscard]] Utilization getUtilization() const;
+
+    /**
+     *  @note The book is accessed by the runner thread until stop() returns
+     */
+    [[nodiscard]] const OrderBook& getOrderBook() const { return _orderBook; }
+
+private:
+    /**
+     *  @brief Deleter of the queue memory
+     */
+    struct FreeMemory
+    {
+        void operator()(void* memory) const;
+    };
+
+    Options                             _options;
+    CompletedCallback                   _completedCallback;
+    OrderBook                           _orderBook;
+    std::unique_ptr<void, FreeMemory>   _queueMemory;
+    SharedQueue<MatchingCommand>        _producerQueue;
+    SharedQueue<MatchingCommand>        _consumerQueue;
+    std::atomic<bool>                   _isStopping;
+    bool                                _isPinned;  ///< Reported by the thread before its first poll
+    std::atomic<uint64_t>               _busyNanoseconds;
+    std::atomic<uint64_t>               _idleNanoseconds;
+    std::atomic<uint64_t>               _commands;
+    std::thread                         _thread;
+
+    /**
+     *  @param pinned Result of pinning, set before the first poll
+     */
+    void run(std::promise<bool>& pinned);
+
+    void process(const MatchingCommand& command);
+
+    static void* allocateQueue(uint32_t capacity);
+};
\ No newline at end of file
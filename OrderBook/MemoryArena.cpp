@@ -0,0 +1,117 @@
+#include "MemoryArena.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <system_error>
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+constexpr int    MemoryArena::NoNumaNode;
+constexpr size_t MemoryArena::HugePageSize;
+constexpr size_t MemoryArena::MinBlockSize;
+
+/// Memory policy of mbind(2), declared here to avoid dependency on libnuma headers
+static constexpr int BindPolicy = 2;  // MPOL_BIND
+
+/**
+ *  @return Index of the smallest size class holding bytes
+ */
+static size_t sizeClass(size_t bytes,
+                        size_t minBlockSize)
+{
+    size_t index = 0;
+    for (size_t blockSize = minBlockSize; blockSize < bytes; blockSize *= 2)
+        ++index;
+    return index;
+}
+
+MemoryArena::MemoryArena(size_t capacity,
+                         bool   useHugePages,
+                         int    numaNode)
+    : _base       ( nullptr )
+    , _capacity   ( (std::max<size_t>(capacity, 1) + HugePageSize - 1) / HugePageSize * HugePageSize )
+    , _used       ( 0 )
+    , _isHugePages( false )
+    , _isNumaBound( false )
+{
+    void* memory = MAP_FAILED;
+#ifdef MAP_HUGETLB
+    if (useHugePages)
+        memory = mmap(nullptr, _capacity, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+#endif
+    _isHugePages = memory != MAP_FAILED;
+    if (not _isHugePages)
+    {
+        memory = mmap(nullptr, _capacity, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (memory == MAP_FAILED)
+            throw std::system_error(errno, std::generic_category(), "mmap of memory arena");
+#ifdef MADV_HUGEPAGE
+        if (useHugePages)
+            madvise(memory, _capacity, MADV_HUGEPAGE);  // Transparent huge pages, best effort
+#endif
+    }
+    _base = static_cast<char*>(memory);
+
+    /// The policy applies to pages faulted afterwards, so binding goes before the region is touched
+#ifdef SYS_mbind
+    if (numaNode >= 0 && numaNode < static_cast<int>( 8 * sizeof(unsigned long) ))
+    {
+        unsigned long nodeMask = 1ul << numaNode;
+        _isNumaBound = syscall(SYS_mbind, _base, _capacity, BindPolicy, &nodeMask, 8 * sizeof(nodeMask) + 1, 0) == 0;
+    }
+#endif
+    std::memset(_base, 0, _capacity);
+
+    _freeBlocks.assign(sizeClass(_capacity, MinBlockSize) + 1, nullptr);
+}
+
+MemoryArena::~MemoryArena()
+{
+    munmap(_base, _capacity);
+}
+
+void* MemoryArena::allocate(size_t bytes)
+{
+    auto index = sizeClass(bytes, MinBlockSize);
+    if (index >= _freeBlocks.size())
+        throw std::bad_alloc();
+
+    /// Freed block keeps the next free block of its class in its first bytes
+    if (_freeBlocks[index] != nullptr)
+    {
+        auto block = _freeBlocks[index];
+        _freeBlocks[index] = *static_cast<void**>(block);
+        return block;
+    }
+
+    auto blockSize = MinBlockSize << index;
+    if (blockSize > _capacity - _used)
+        throw std::bad_alloc();
+    auto block = _base + _used;
+    _used += blockSize;
+    return block;
+}
+
+void MemoryArena::deallocate(void*  pointer,
+                             size_t bytes)
+{
+    if (pointer == nullptr)
+        return;
+    auto index = sizeClass(bytes, MinBlockSize);
+    *static_cast<void**>(pointer) = _freeBlocks[index];
+    _freeBlocks[index] = pointer;
+}
+
+int MemoryArena::currentNumaNode()
+{
+    unsigned cpu  = 0;
+    unsigned node = 0;
+#ifdef SYS_getcpu
+    if (syscall(SYS_getcpu, &cpu, &node, nullptr) != 0)
+        return 0;
+#endif
+    return static_cast<int>(node);
+}
\ No newline at end of file
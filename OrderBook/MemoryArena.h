@@ -0,0 +1,150 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+/**
+ *  @brief Fixed region of memory for book storage, backed by 2MB huge pages where the system provides them
+ *
+ *  @details The region is mapped once with MAP_HUGETLB and falls back to normal pages with transparent huge
+ *           page advice in case no huge pages are reserved. It is optionally bound to a NUMA node and touched
+ *           up front, so storage growth on the hot path neither faults nor misses the TLB as often.
+ *           Blocks are rounded up to power of two size classes and freed blocks are reused by later
+ *           allocations of the same class, which suits geometrically growing vectors.
+ *
+ *  @note Not thread safe, an arena serves books of one thread
+ */
+class MemoryArena
+{
+public:
+    static constexpr int    NoNumaNode   = -1;
+    static constexpr size_t HugePageSize = 2 * 1024 * 1024;
+
+    /**
+     *  @param capacity     Region size in bytes, rounded up to the huge page size
+     *  @param useHugePages Try MAP_HUGETLB first
+     *  @param numaNode     Node to place the region on, NoNumaNode keeps the default policy
+     *
+     *  @throws std::system_error Thrown in case the region cannot be mapped at all
+     */
+    explicit MemoryArena(size_t capacity,
+                         bool   useHugePages = true,
+                         int    numaNode     = NoNumaNode);
+    ~MemoryArena();
+
+    MemoryArena(const MemoryArena&)            = delete;
+    MemoryArena& operator=(const MemoryArena&) = delete;
+
+    /**
+     *  @throws std::bad_alloc Thrown in case the region is exhausted
+     */
+    void* allocate(size_t bytes);
+
+    void deallocate(void*  pointer,
+                    size_t bytes);
+
+    /**
+     *  @return true if the region is backed by explicitly reserved huge pages
+     */
+    [[nodiscard]] bool isHugePages() const { return _isHugePages; }
+
+    /**
+     *  @return true if the region is bound to the requested NUMA node
+     */
+    [[nodiscard]] bool isNumaBound() const { return _isNumaBound; }
+
+    [[nodiscard]] size_t getCapacity() const { return _capacity; }
+
+    /**
+     *  @return Bytes of the region handed out at least once, freed blocks stay counted
+     */
+    [[nodiscard]] size_t getUsed() const { return _used; }
+
+    /**
+     *  @return NUMA node of the CPU the calling thread runs on, 0 in case it is unknown
+     */
+    static int currentNumaNode();
+
+private:
+    static constexpr size_t MinBlockSize = 64;  ///< Cache line, so blocks never share lines
+
+    char*               _base;
+    size_t              _capacity;
+    size_t              _used;
+    bool                _isHugePages;
+    bool                _isNumaBound;
+    std::vector<void*>  _freeBlocks;  ///< Head of intrusive free list per size class
+};
+
+/**
+ *  @brief Standard allocator drawing from MemoryArena, null arena means the default heap
+ *
+ *  @details Copies of containers go to the default heap, so a cloned book never shares an arena
+ *           with a book of another thread. Copy assignment keeps the arena of the target.
+ */
+template <typename T>
+class ArenaAllocator
+{
+public:
+    using value_type = T;
+
+    using propagate_on_container_copy_assignment = std::false_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap            = std::true_type;
+
+    ArenaAllocator() noexcept
+        : _arena( nullptr )
+    {}
+
+    explicit ArenaAllocator(MemoryArena* arena) noexcept
+        : _arena( arena )
+    {}
+
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept  // NOLINT: rebinding is implicit
+        : _arena( other.getArena() )
+    {}
+
+    [[nodiscard]] MemoryArena* getArena() const { return _arena; }
+
+    T* allocate(size_t count)
+    {
+        if (_arena == nullptr)
+            return static_cast<T*>( ::operator new( count * sizeof(T) ) );
+        return static_cast<T*>( _arena->allocate( count * sizeof(T) ) );
+    }
+
+    void deallocate(T*     pointer,
+                    size_t count) noexcept
+    {
+        if (_arena == nullptr)
+            ::operator delete(pointer);
+        else
+            _arena->deallocate( pointer, count * sizeof(T) );
+    }
+
+    ArenaAllocator select_on_container_copy_construction() const { return ArenaAllocator(); }
+
+private:
+    MemoryArena* _arena;
+};
+
+template <typename T, typename U>
+bool operator==(const ArenaAllocator<T>& first,
+                const ArenaAllocator<U>& second)
+{
+    return first.getArena() == second.getArena();
+}
+
+template <typename T, typename U>
+bool operator!=(const ArenaAllocator<T>& first,
+                const ArenaAllocator<U>& second)
+{
+    return not (first == second);
+}
+
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
\ No newline at end of file
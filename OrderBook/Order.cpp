@@ -1,18 +1,37 @@
 #include "Order.h"
 
+constexpr Order::OwnerType Order::NoOwner;
+constexpr Order::TimeType  Order::NoExpiry;
+
 Order::Order()
-    : _price   (0)
+    : _id      (0)
+    , _price   (0)
     , _quantity(0)
-    , _id      (0)
+    , _owner   (NoOwner)
+    , _type    (Type::Ask)
 {}
 
 Order::Order(Type         type,
              PriceType    price,
-             QuantityType quantity)
-    : _type    (type)
+             QuantityType quantity,
+             OwnerType    owner)
+    : _id      (++_nextId)
     , _price   (price)
     , _quantity(quantity)
-    , _id      (++_nextId)
+    , _owner   (owner)
+    , _type    (type)
+{}
+
+Order::Order(Type         type,
+             IdType       id,
+             PriceType    price,
+             QuantityType quantity,
+             OwnerType    owner)
+    : _id      (id)
+    , _price   (price)
+    , _quantity(quantity)
+    , _owner   (owner)
+    , _type    (type)
 {}
 
 Order Order::split(QuantityType quantity,
@@ -28,4 +47,11 @@ Order Order::split(QuantityType quantity,
     _quantity -= quantity;
 
     return newOrder;
+}
+
+void Order::amend(PriceType    price,
+                  QuantityType quantity)
+{
+    _price    = price;
+    _quantity = quantity;
 }
\ No newline at end of file
@@ -6,21 +6,43 @@
 class Order
 {
 public:
-    enum class Type
+    enum class Type : uint8_t
     {
         Ask,
         Bid
     };
     using IdType       = uint64_t;
+#ifdef ORDERBOOK_WIDE_PRICES
+    using PriceType    = int64_t;  ///< Fixed point prices with many decimals, e.g. crypto
+#else
     using PriceType    = int32_t;
+#endif
     using QuantityType = uint32_t;
+    using OwnerType    = uint32_t;
+    using TimeType     = uint64_t;
 
-    Order(Type, PriceType, QuantityType);
+    /**
+     *  @brief Sum of quantities of many orders, e.g. price level total, which does not fit QuantityType
+     */
+    using TotalQuantityType = uint64_t;
+
+    /**
+     *  @brief Owner of orders which do not belong to any client session
+     */
+    static constexpr OwnerType NoOwner = 0;
+
+    /**
+     *  @brief Expiry of good till cancel orders
+     */
+    static constexpr TimeType NoExpiry = 0;
+
+    Order(Type, PriceType, QuantityType, OwnerType = NoOwner);
 
     [[nodiscard]] Type         getType    () const { return _type;     }
     [[nodiscard]] PriceType    getPrice   () const { return _price;    }
     [[nodiscard]] QuantityType getQuantity() const { return _quantity; }
     [[nodiscard]] IdType       getId      () const { return _id;       }
+    [[nodiscard]] OwnerType    getOwner   () const { return _owner;    }
 
     /**
      *  @brief Create explicitly empty order to save an order from split
@@ -34,14 +56,27 @@ public:
     Order split(QuantityType quantity,
                 PriceType    executionPrice);
 
+    /**
+     *  @brief Replace price and quantity keeping the same ID and type
+     */
+    void amend(PriceType    price,
+               QuantityType quantity);
+
 private:
-    Type         _type;
+    friend class OrderBook;
+    friend class OrderPool;
+
+    /**
+     *  @note Fields are ordered by size to avoid alignment padding
+     */
     IdType       _id;
     PriceType    _price;
     QuantityType _quantity;
+    OwnerType    _owner;
+    Type         _type;
 
     /**
-     *  @brief ID generator for new order
+     *  @brief ID generator for orders created outside of order book, the book has its own sequence
      */
     static IdType _nextId;
 
@@ -49,4 +84,9 @@ private:
      *  @note Forbid creating objects via default constructor
      */
     Order();
+
+    /**
+     *  @brief Create order with ID of the book sequence or restore order kept in OrderPool
+     */
+    Order(Type, IdType, PriceType, QuantityType, OwnerType);
 };
\ No newline at end of file
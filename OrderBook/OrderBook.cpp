@@ -1,172 +1,874 @@
 #include "OrderBook.h"
+#include "DepthKernels.h"
 
+#include <algorithm>
+#include <cstdlib>
 #include <iomanip>
+#include <limits>
 #include <sstream>
 
 uint64_t Order::_nextId = 0;
 
-OrderBook::OrderBook(OrderCallback executedOrderCallback,
-                     OrderCallback canceledOrderCallback)
-    : _executedOrderCallback  ( std::move(executedOrderCallback) )
+OrderBook::OrderBook(OrderCallback      executedOrderCallback,
+                     OrderCallback      canceledOrderCallback,
+                     OrderBatchCallback canceledBatchCallback,
+                     MemoryArena*       arena)
+    : _orders                 ( arena )
+    , _askLevels              ( Order::Type::Ask, arena )
+    , _bidLevels              ( Order::Type::Bid, arena )
+    , _idIndex                ( arena )
+    , _executedOrderCallback  ( std::move(executedOrderCallback) )
     , _canceledOrderCallback  ( std::move(canceledOrderCallback) )
+    , _canceledBatchCallback  ( std::move(canceledBatchCallback) )
+    , _l3Sequence             ( 0 )
     , _haveTransactionsStarted( false )
     , _lastPrice              ( 0 )
     , _lastQuantity           ( 0 )
+    , _triggerLow             ( std::numeric_limits<Order::PriceType>::max() )
+    , _triggerHigh            ( std::numeric_limits<Order::PriceType>::min() )
+    , _auctionMode            ( false )
+    , _nextOrderId            ( 0 )
 {}
 
+OrderBook OrderBook::clone(OrderCallback      executedOrderCallback,
+                           OrderCallback      canceledOrderCallback,
+                           OrderBatchCallback canceledBatchCallback) const
+{
+    OrderBook copy(*this);
+    copy._executedOrderCallback = std::move(executedOrderCallback);
+    copy._canceledOrderCallback = std::move(canceledOrderCallback);
+    copy._canceledBatchCallback = std::move(canceledBatchCallback);
+    copy._l3Callback            = nullptr;
+    return copy;
+}
+
+void OrderBook::copyStateFrom(const OrderBook& other)
+{
+    if (this == &other)
+        return;
+
+    /// Member-wise vector assignment reuses capacity of this book
+    auto executedOrderCallback = std::move(_executedOrderCallback);
+    auto canceledOrderCallback = std::move(_canceledOrderCallback);
+    auto canceledBatchCallback = std::move(_canceledBatchCallback);
+    auto l3Callback            = std::move(_l3Callback);
+    *this = other;
+    _executedOrderCallback = std::move(executedOrderCallback);
+    _canceledOrderCallback = std::move(canceledOrderCallback);
+    _canceledBatchCallback = std::move(canceledBatchCallback);
+    _l3Callback            = std::move(l3Callback);
+}
+
 void OrderBook::sendExecutedOrder(Order order)
 {
     if (_executedOrderCallback)
         _executedOrderCallback(order);
 }
 
-template <typename Container>
-bool OrderBook::tryExecute(Order&                      order,
-                           Container&                  container,
-                           const CompareOrderFunction& possibleExecution)
+void OrderBook::executeRestingOrder(PriceLevels&            levels,
+                                    PriceLevels::LevelIndex level,
+                                    OrderPool::SlotIndex    slot,
+                                    Order::QuantityType     quantity,
+                                    Order::PriceType        executionPrice)
 {
-    Order containerOrder = Order::makeEmptyOrder();
+    auto restingOrder = _orders.restore(slot);
+    sendExecutedOrder( restingOrder.split(quantity, executionPrice) );  // May be full order or a part
 
-    for (auto it = container.begin();
-         it != container.end() && order.getQuantity() > 0 &&
-         possibleExecution( it->getPrice(), order.getPrice() );)
+    /// Remove fully executed order from book, the rest part keeps its place in the queue
+    levels.reduce(_orders, level, slot, quantity);
+    if (_orders.hot(slot).quantity == 0)
     {
-        /// Remove first order from book
-        containerOrder = *it;
-        _idOrderLink.erase( it->getId() );
-        it = container.erase(it);
-
-        /// Determine execution parameters
-        auto executionQuantity = std::min( containerOrder.getQuantity(), order.getQuantity() );
-        auto executionPrice = containerOrder.getPrice();
-
-        /// Execution
-        auto executedOrder = containerOrder.split(executionQuantity, executionPrice);
-        sendExecutedOrder(executedOrder);  // May be full order or a part
-        auto executedIncomingOrder = order.split(executionQuantity, executionPrice);
-        sendExecutedOrder(executedIncomingOrder);  // May be full order or a part
-
-        /// Update market data
-        if (_haveTransactionsStarted && _lastPrice == executionPrice)
-            _lastQuantity += executionQuantity;
-        else
-            _lastQuantity = executionQuantity;
-        _lastPrice = executionPrice;
-        _haveTransactionsStarted = true;
+        publishL3(L3Event::Kind::Remove, slot);
+        levels.unlink(_orders, level, slot);
+        removeOrder(slot);
     }
+    else
+        publishL3(L3Event::Kind::Reduce, slot);
+}
+
+void OrderBook::updateMarketData(Order::PriceType    executionPrice,
+                                 Order::QuantityType executionQuantity)
+{
+    if (_haveTransactionsStarted && _lastPrice == executionPrice)
+        _lastQuantity += executionQuantity;
+    else
+        _lastQuantity = executionQuantity;
+    _lastPrice = executionPrice;
+    _haveTransactionsStarted = true;
+    _tradeStatistics       .update(executionPrice, executionQuantity);
+    _rollingTradeStatistics.update(executionPrice, executionQuantity);
 
-    if (containerOrder.getQuantity() != 0)  // Return the rest part of order to OrderBook
+    /// Two comparisons per trade however many stops are pending, stops are released after matching
+    if ( _stopOrders.triggers(executionPrice) )
     {
-        auto res = container.emplace(containerOrder);
-        auto& it = res.first;
-        assert(res.second);
-        _idOrderLink.emplace( std::make_pair(it->getId(), it) );
+        _triggerLow  = std::min(_triggerLow,  executionPrice);
+        _triggerHigh = std::max(_triggerHigh, executionPrice);
     }
+}
+
+bool OrderBook::tryExecute(Order&       order,
+                           PriceLevels& levels)
+{
+    while ( order.getQuantity() > 0 && not levels.empty() && levels.crosses( order.getPrice() ) )
+    {
+        auto level = levels.best();
+        auto executionPrice = levels.price(level);
+
+        while ( order.getQuantity() > 0 && levels.queue(level).head != OrderPool::InvalidSlot )
+        {
+            auto slot = levels.queue(level).head;
+
+            /// Determine execution parameters
+            auto executionQuantity = std::min( _orders.hot(slot).quantity, order.getQuantity() );
+
+            /// Execution
+            executeRestingOrder(levels, level, slot, executionQuantity, executionPrice);
+            auto executedIncomingOrder = order.split(executionQuantity, executionPrice);
+            sendExecutedOrder(executedIncomingOrder);  // May be full order or a part
+
+            updateMarketData(executionPrice, executionQuantity);
+        }
+
+        if (levels.queue(level).head == OrderPool::InvalidSlot)
+            levels.erase(level);
+    }
+
     return order.getQuantity() == 0;
 }
 
 bool OrderBook::tryExecute(Order& order)
 {
     if (order.getType() == Order::Type::Bid)
-    {
-        return tryExecute(order, _askQueue,
-                          [](Order::PriceType priceOrderInQueue, Order::PriceType priceOrderCome)
-                          {
-                              return priceOrderInQueue <= priceOrderCome;
-                          });
-    }
+        return tryExecute(order, _askLevels);
     else  // Order::Type::Ask
-    {
-        return tryExecute(order, _bidQueue,
-                          [](Order::PriceType priceOrderInQueue, Order::PriceType priceOrderCome)
-                          {
-                              return priceOrderInQueue >= priceOrderCome;
-                          });
-    }
+        return tryExecute(order, _bidLevels);
 }
 
 bool OrderBook::checkConsistency() const
 {
-    return _askQueue.size() + _bidQueue.size() == _idOrderLink.size();
+    return _orders.size() == _idIndex.size();
+}
+
+void OrderBook::placeOrder(OrderPool::SlotIndex slot)
+{
+    const auto& cold = _orders.cold(slot);
+    auto& sideLevels = levels(cold.type);
+    sideLevels.pushBack( _orders, sideLevels.findOrInsert(cold.price), slot );
+    publishL3(L3Event::Kind::Add, slot);
+}
+
+void OrderBook::sendL3(L3Event::Kind        kind,
+                       OrderPool::SlotIndex slot)
+{
+    const auto& cold = _orders.cold(slot);
+    L3Event event;
+    event.sequence = _l3Sequence;
+    event.kind     = kind;
+    event.type     = cold.type;
+    event.id       = cold.id;
+    event.price    = cold.price;
+    event.quantity = kind == L3Event::Kind::Remove ? 0 : _orders.hot(slot).quantity;
+    _l3Callback(event);
+}
+
+void OrderBook::unlinkOrder(OrderPool::SlotIndex slot)
+{
+    const auto& cold = _orders.cold(slot);
+    auto& sideLevels = levels(cold.type);
+    auto levelPair = sideLevels.find(cold.price);
+    assert(levelPair.first);
+    publishL3(L3Event::Kind::Remove, slot);
+
+    sideLevels.unlink(_orders, levelPair.second, slot);
+    if (sideLevels.queue(levelPair.second).head == OrderPool::InvalidSlot)
+        sideLevels.erase(levelPair.second);
+}
+
+void OrderBook::removeOrder(OrderPool::SlotIndex slot)
+{
+    _ownerLists .unlink(_orders, slot);
+    _timingWheel.unlink(_orders, slot);
+    _idIndex.erase( _orders.cold(slot).id );
+    _orders.release(slot);
 }
 
 Order::IdType OrderBook::addOrder(Order::Type         type,
                                   Order::PriceType    price,
-                                  Order::QuantityType quantity)
+                                  Order::QuantityType quantity,
+                                  Order::OwnerType    owner,
+                                  Order::TimeType     expiry)
 {
-    Order order(type, price, quantity);
-    Order::IdType id = order.getId();
+    return addOrderWithHandle(type, price, quantity, owner, expiry).id;
+}
+
+OrderBook::OrderHandle OrderBook::addOrderWithHandle(Order::Type         type,
+                                                     Order::PriceType    price,
+                                                     Order::QuantityType quantity,
+                                                     Order::OwnerType    owner,
+                                                     Order::TimeType     expiry)
+{
+    Order order(type, ++_nextOrderId, price, quantity, owner);
+    auto handle = enterOrder(order, expiry);
+    releaseTriggeredStops();
+    return handle;
+}
 
-    auto isFullyExecuted = tryExecute(order);
-    if (not isFullyExecuted)  // Place order to book
+OrderBook::OrderHandle OrderBook::enterOrder(Order&          order,
+                                             Order::TimeType expiry)
+{
+    OrderHandle handle;
+    handle.id = order.getId();
+
+    auto isFullyExecuted = not _auctionMode && tryExecute(order);
+    bool isExpired = expiry != Order::NoExpiry && expiry <= _timingWheel.getTime();
+    if (not isFullyExecuted && isExpired)
+    {
+        if (_canceledOrderCallback)
+            _canceledOrderCallback(order);
+    }
+    else if (not isFullyExecuted)  // Place order to book
     {
-        std::pair<OrderContainerIterator, bool> res;
-        res = ( type == Order::Type::Bid ? _bidQueue.emplace(order) : _askQueue.emplace(order) );
-        assert(res.second);
-        auto& it = res.first;
-        _idOrderLink.emplace( std::make_pair(it->getId(), it) );
+        handle.slot       = _orders.allocate(order);
+        handle.generation = _orders.cold(handle.slot).generation;
+        placeOrder(handle.slot);
+        _idIndex.insert(handle.id, handle.slot);
+        _ownerLists.link(_orders, handle.slot);
+        if (expiry != Order::NoExpiry)
+            _timingWheel.link(_orders, handle.slot, expiry);
     }
 
     assert( checkConsistency() );
-    return id;
+    return handle;
 }
 
-OrderBook::IdOrderLink::const_iterator OrderBook::findOrder(Order::IdType id) const
+Order::IdType OrderBook::addStopOrder(Order::Type         type,
+                                      Order::PriceType    stopPrice,
+                                      Order::QuantityType quantity,
+                                      Order::OwnerType    owner)
 {
-    auto orderLink = _idOrderLink.find(id);
-    if ( orderLink == _idOrderLink.end() )
-        throw NotFoundException( std::string("Order id ") + std::to_string(id) + "not found" );
-    return orderLink;
+    StopOrders::StopOrder stop;
+    stop.id        = ++_nextOrderId;
+    stop.stopPrice = stopPrice;
+    stop.price     = stopPrice;
+    stop.quantity  = quantity;
+    stop.owner     = owner;
+    stop.type      = type;
+    stop.isLimit   = false;
+    _stopOrders.add(stop);
+    return stop.id;
 }
 
-void OrderBook::cancelOrder(Order::IdType id)
+Order::IdType OrderBook::addStopLimitOrder(Order::Type         type,
+                                           Order::PriceType    stopPrice,
+                                           Order::PriceType    price,
+                                           Order::QuantityType quantity,
+                                           Order::OwnerType    owner)
+{
+    StopOrders::StopOrder stop;
+    stop.id        = ++_nextOrderId;
+    stop.stopPrice = stopPrice;
+    stop.price     = price;
+    stop.quantity  = quantity;
+    stop.owner     = owner;
+    stop.type      = type;
+    stop.isLimit   = true;
+    _stopOrders.add(stop);
+    return stop.id;
+}
+
+OrderBook::CancelStatus OrderBook::tryCancelStopOrder(Order::IdType id)
 {
-    auto orderLink = findOrder(id);
+    auto stopPair = _stopOrders.erase(id);
+    if (not stopPair.first)
+        return CancelStatus::NotFound;
+
+    const auto& stop = stopPair.second;
     if (_canceledOrderCallback)
-        _canceledOrderCallback( *(orderLink->second) );
+        _canceledOrderCallback( Order(stop.type, stop.id, stop.price, stop.quantity, stop.owner) );
+    return CancelStatus::Canceled;
+}
+
+void OrderBook::releaseTriggeredStops()
+{
+    StopOrders::StopOrder stop;
+    while ( _triggerLow <= _triggerHigh && _stopOrders.popTriggered(_triggerLow, _triggerHigh, stop) )
+    {
+        if (stop.isLimit)
+        {
+            Order order(stop.type, stop.id, stop.price, stop.quantity, stop.owner);
+            enterOrder(order, Order::NoExpiry);
+            continue;
+        }
+
+        /// Market order crosses every price level of the opposite side and never rests
+        auto marketPrice = stop.type == Order::Type::Bid ? std::numeric_limits<Order::PriceType>::max()
+                                                         : std::numeric_limits<Order::PriceType>::min();
+        Order order(stop.type, stop.id, marketPrice, stop.quantity, stop.owner);
+        if ( not tryExecute(order) && _canceledOrderCallback )
+        {
+            order.amend(stop.stopPrice, order.getQuantity());
+            _canceledOrderCallback(order);
+        }
+    }
+    _triggerLow  = std::numeric_limits<Order::PriceType>::max();
+    _triggerHigh = std::numeric_limits<Order::PriceType>::min();
+}
+
+OrderPool::SlotIndex OrderBook::resolve(const OrderHandle& handle) const
+{
+    if ( not _orders.isValid(handle.slot, handle.generation) || _orders.cold(handle.slot).id != handle.id )
+        return OrderPool::InvalidSlot;
+    return handle.slot;
+}
+
+void OrderBook::startAuction()
+{
+    _auctionMode = true;
+}
+
+OrderBook::AuctionResult OrderBook::getIndicativeAuctionResult() const
+{
+    AuctionResult result;
+    if ( _askLevels.empty() || _bidLevels.empty() ||
+         _bidLevels.price( _bidLevels.best() ) < _askLevels.price( _askLevels.best() ) )
+        return result;
+
+    /// Candidate prices are crossed level prices of both sides visited in ascending order:
+    /// ask levels from the best one, bid levels from the worst crossed one
+    auto askLevel = _askLevels.size();
+    auto bidLevel = _bidLevels.size() - _bidLevels.crossingCount( _askLevels.price( _askLevels.best() ) );
+    auto bestBidPrice = _bidLevels.price( _bidLevels.best() );
+
+    uint64_t supply = 0;  // Ask quantity with price <= candidate
+    uint64_t demand = DepthKernels::sum( _bidLevels.quantities() + bidLevel, _bidLevels.size() - bidLevel );
+    uint64_t bestSurplus = 0;
+
+    while ( ( askLevel > 0 && _askLevels.price(askLevel - 1) <= bestBidPrice ) || bidLevel < _bidLevels.size() )
+    {
+        Order::PriceType price;
+        if ( bidLevel == _bidLevels.size() ||
+             ( askLevel > 0 && _askLevels.price(askLevel - 1) <= _bidLevels.price(bidLevel) ) )
+            price = _askLevels.price(askLevel - 1);
+        else
+            price = _bidLevels.price(bidLevel);
+
+        /// Account asks at the candidate price, bids at the candidate price are still accounted by demand
+        while ( askLevel > 0 && _askLevels.price(askLevel - 1) <= price )
+            supply += _askLevels.quantity(--askLevel);
+
+        auto quantity = std::min(supply, demand);
+        auto surplus  = std::max(supply, demand) - quantity;
+        bool isBetter = quantity > result.quantity ||
+                        ( quantity == result.quantity && surplus < bestSurplus ) ||
+                        ( quantity == result.quantity && surplus == bestSurplus && _haveTransactionsStarted &&
+                          std::abs( static_cast<int64_t>(price) - _lastPrice ) <
+                          std::abs( static_cast<int64_t>(result.price) - _lastPrice ) );
+        if (isBetter)
+        {
+            result.price    = price;
+            result.quantity = quantity;
+            bestSurplus     = surplus;
+        }
+
+        /// Bids at the candidate price do not take part at higher prices
+        while ( bidLevel < _bidLevels.size() && _bidLevels.price(bidLevel) <= price )
+            demand -= _bidLevels.quantity(bidLevel++);
+    }
+    return result;
+}
+
+OrderBook::AuctionResult OrderBook::uncross()
+{
+    auto result = getIndicativeAuctionResult();
+    _auctionMode = false;
+
+    for (auto remaining = result.quantity; remaining > 0;)
+    {
+        auto bidLevel = _bidLevels.best();
+        auto askLevel = _askLevels.best();
+        auto bidSlot  = _bidLevels.queue(bidLevel).head;
+        auto askSlot  = _askLevels.queue(askLevel).head;
+        assert( _bidLevels.price(bidLevel) >= result.price && _askLevels.price(askLevel) <= result.price );
+
+        auto executionQuantity = static_cast<Order::QuantityType>(
+                std::min<uint64_t>( remaining, std::min( _orders.hot(bidSlot).quantity, _orders.hot(askSlot).quantity ) ) );
+        executeRestingOrder(_bidLevels, bidLevel, bidSlot, executionQuantity, result.price);
+        executeRestingOrder(_askLevels, askLevel, askSlot, executionQuantity, result.price);
+        updateMarketData(result.price, executionQuantity);
+        remaining -= executionQuantity;
+
+        if (_bidLevels.queue(bidLevel).head == OrderPool::InvalidSlot)
+            _bidLevels.erase(bidLevel);
+        if (_askLevels.queue(askLevel).head == OrderPool::InvalidSlot)
+            _askLevels.erase(askLevel);
+    }
+
+    assert( checkConsistency() );
+    releaseTriggeredStops();
+    return result;
+}
+
+[[noreturn]] static void throwOrderNotFound(Order::IdType id)
+{
+    throw NotFoundException( std::string("Order id ") + std::to_string(id) + "not found" );
+}
+
+OrderPool::SlotIndex OrderBook::findOrder(Order::IdType id) const
+{
+    auto slot = _idIndex.find(id);
+    if (slot == OrderPool::InvalidSlot)
+        throwOrderNotFound(id);
+    return slot;
+}
+
+OrderBook::CancelStatus OrderBook::tryCancelOrder(Order::IdType id)
+{
+    auto slot = _idIndex.find(id);
+    if (slot == OrderPool::InvalidSlot)
+        return CancelStatus::NotFound;
+
+    cancelSlot(slot);
+    return CancelStatus::Canceled;
+}
+
+OrderBook::CancelStatus OrderBook::tryCancelOrder(const OrderHandle& handle)
+{
+    auto slot = resolve(handle);
+    if (slot == OrderPool::InvalidSlot)
+        return CancelStatus::NotFound;
+
+    cancelSlot(slot);
+    return CancelStatus::Canceled;
+}
+
+void OrderBook::cancelSlot(OrderPool::SlotIndex slot)
+{
+    if (_canceledOrderCallback)
+        _canceledOrderCallback( _orders.restore(slot) );
+
+    unlinkOrder(slot);
+    removeOrder(slot);
+
+    assert( checkConsistency() );
+}
+
+size_t OrderBook::removeLevels(PriceLevels&            levels,
+                               PriceLevels::LevelIndex first,
+                               PriceLevels::LevelIndex last,
+                               bool                    releaseSlots)
+{
+    bool collectOrders = _canceledBatchCallback || _canceledOrderCallback;
+    size_t count = 0;
+
+    /// Orders are reported in priority order: from the best level to the worst one
+    for (auto level = last; level-- > first;)
+    {
+        for (auto slot = levels.queue(level).head; slot != OrderPool::InvalidSlot;)
+        {
+            auto next = _orders.hot(slot).next;
+            if (collectOrders)
+                _canceledBatch.push_back( _orders.restore(slot) );
+            publishL3(L3Event::Kind::Remove, slot);
+            if (releaseSlots)
+                removeOrder(slot);
+            else
+                _idIndex.erase( _orders.cold(slot).id );
+            slot = next;
+            ++count;
+        }
+    }
+    levels.erase(first, last);
+    return count;
+}
+
+void OrderBook::sendCanceledBatch()
+{
+    if (_canceledBatchCallback)
+        _canceledBatchCallback(_canceledBatch);
+    else if (_canceledOrderCallback)
+    {
+        for (const auto& order : _canceledBatch)
+            _canceledOrderCallback(order);
+    }
+    _canceledBatch.clear();
+}
+
+size_t OrderBook::cancelAllOrders()
+{
+    auto count = removeLevels(_askLevels, 0, _askLevels.size(), false) +
+                 removeLevels(_bidLevels, 0, _bidLevels.size(), false);
+    /// IDs are erased one by one, sweeping the whole index costs its capacity even for a few orders
+    assert( _idIndex.size() == 0 );
+    _ownerLists .clear();
+    _timingWheel.clear();
+    _orders     .clear();
 
-    orderLink->second->getType() == Order::Type::Ask ?
-        _askQueue.erase(orderLink->second) :
-        _bidQueue.erase(orderLink->second);
-    _idOrderLink.erase(orderLink);
+    assert( checkConsistency() );
+    sendCanceledBatch();
+    return count;
+}
+
+size_t OrderBook::cancelOrders(Order::Type type)
+{
+    auto& sideLevels = levels(type);
+    auto count = removeLevels(sideLevels, 0, sideLevels.size(), true);
+
+    assert( checkConsistency() );
+    sendCanceledBatch();
+    return count;
+}
+
+size_t OrderBook::cancelOrders(Order::Type      type,
+                               Order::PriceType minPrice,
+                               Order::PriceType maxPrice)
+{
+    auto& sideLevels = levels(type);
+    if (minPrice > maxPrice)
+        return 0;
+
+    auto levelRange = sideLevels.range(minPrice, maxPrice);
+    auto count = removeLevels(sideLevels, levelRange.first, levelRange.second, true);
 
     assert( checkConsistency() );
+    sendCanceledBatch();
+    return count;
+}
+
+size_t OrderBook::cancelAllForOwner(Order::OwnerType owner)
+{
+    assert(owner != Order::NoOwner);
+    bool collectOrders = _canceledBatchCallback || _canceledOrderCallback;
+    size_t count = 0;
+
+    for (auto slot = _ownerLists.head(owner); slot != OrderPool::InvalidSlot; ++count)
+    {
+        auto next = _orders.owner(slot).next;
+        if (collectOrders)
+            _canceledBatch.push_back( _orders.restore(slot) );
+        unlinkOrder(slot);
+        removeOrder(slot);
+        slot = next;
+    }
+
+    if ( not _stopOrders.empty() )
+    {
+        count += _stopOrders.eraseOwner(owner, _ownerStops);
+        if (collectOrders)
+        {
+            for (const auto& stop : _ownerStops)
+                _canceledBatch.push_back( Order(stop.type, stop.id, stop.price, stop.quantity, stop.owner) );
+        }
+        _ownerStops.clear();
+    }
+
+    assert( checkConsistency() );
+    sendCanceledBatch();
+    return count;
+}
+
+OrderBook::MassQuoteResult OrderBook::massQuote(Order::OwnerType            owner,
+                                                const std::vector<Quote>&   quotes,
+                                                std::vector<Order::IdType>& ids)
+{
+    assert(owner != Order::NoOwner);
+    bool collectOrders = _canceledBatchCallback || _canceledOrderCallback;
+    MassQuoteResult result;
+    ids.assign(quotes.size(), 0);
+    _quoteSlots.assign(quotes.size(), OrderPool::InvalidSlot);
+
+    /// Every resting order of owner is either reused by a quote at its side and price or canceled
+    for (auto slot = _ownerLists.head(owner); slot != OrderPool::InvalidSlot;)
+    {
+        auto next = _orders.owner(slot).next;
+        const auto& cold = _orders.cold(slot);
+        size_t i = 0;
+        while ( i < quotes.size() && (_quoteSlots[i] != OrderPool::InvalidSlot || quotes[i].quantity == 0 ||
+                                      quotes[i].type != cold.type || quotes[i].price != cold.price) )
+            ++i;
+        if (i < quotes.size())
+        {
+            _quoteSlots[i] = slot;
+            ids[i]         = cold.id;
+        }
+        else
+        {
+            if (collectOrders)
+                _canceledBatch.push_back( _orders.restore(slot) );
+            unlinkOrder(slot);
+            removeOrder(slot);
+            ++result.canceled;
+        }
+        slot = next;
+    }
+    if (result.canceled > 0)
+        sendCanceledBatch();
+
+    /// Reused orders are updated before adding new ones, which may execute against them
+    for (size_t i = 0; i < quotes.size(); ++i)
+    {
+        auto slot = _quoteSlots[i];
+        if (slot == OrderPool::InvalidSlot)
+            continue;
+
+        auto& hot = _orders.hot(slot);
+        auto& sideLevels = levels(quotes[i].type);
+        if (quotes[i].quantity == hot.quantity)
+            ++result.kept;
+        else if (quotes[i].quantity < hot.quantity)
+        {
+            sideLevels.reduce( _orders, sideLevels.find(quotes[i].price).second, slot, hot.quantity - quotes[i].quantity );
+            publishL3(L3Event::Kind::Reduce, slot);
+            ++result.amended;
+        }
+        else
+        {
+            /// Resting order does not cross the opposite side, so it is placed back without matching
+            unlinkOrder(slot);
+            hot.quantity = quotes[i].quantity;
+            placeOrder(slot);
+            ++result.amended;
+        }
+    }
+
+    for (size_t i = 0; i < quotes.size(); ++i)
+    {
+        if (_quoteSlots[i] != OrderPool::InvalidSlot || quotes[i].quantity == 0)
+            continue;
+
+        Order order(quotes[i].type, ++_nextOrderId, quotes[i].price, quotes[i].quantity, owner);
+        ids[i] = enterOrder(order, Order::NoExpiry).id;
+        ++result.added;
+    }
+
+    assert( checkConsistency() );
+    releaseTriggeredStops();
+    return result;
+}
+
+size_t OrderBook::advanceTime(Order::TimeType now)
+{
+    _timingWheel.advance(_orders, now, _expiredSlots);
+    bool collectOrders = _canceledBatchCallback || _canceledOrderCallback;
+    for (auto slot : _expiredSlots)
+    {
+        if (collectOrders)
+            _canceledBatch.push_back( _orders.restore(slot) );
+        unlinkOrder(slot);
+        removeOrder(slot);
+    }
+    auto count = _expiredSlots.size();
+    _expiredSlots.clear();
+
+    assert( checkConsistency() );
+    if (count > 0)  // Called on every clock tick, empty batches are not reported
+        sendCanceledBatch();
+    return count;
+}
+
+void OrderBook::cancelOrder(Order::IdType id)
+{
+    if (tryCancelOrder(id) == CancelStatus::NotFound)
+        throwOrderNotFound(id);
+}
+
+void OrderBook::cancelOrder(const OrderHandle& handle)
+{
+    if (tryCancelOrder(handle) == CancelStatus::NotFound)
+        throwOrderNotFound(handle.id);
+}
+
+void OrderBook::amendOrder(Order::IdType       id,
+                           Order::PriceType    newPrice,
+                           Order::QuantityType newQuantity)
+{
+    auto slot = findOrder(id);
+    if (newQuantity == 0)
+    {
+        cancelSlot(slot);
+        return;
+    }
+
+    auto& hot = _orders.hot(slot);
+    const auto& cold = _orders.cold(slot);
+    if (cold.price == newPrice && newQuantity <= hot.quantity)
+    {
+        /// Order keeps its place in the queue
+        auto& sideLevels = levels(cold.type);
+        sideLevels.reduce( _orders, sideLevels.find(cold.price).second, slot, hot.quantity - newQuantity );
+        publishL3(L3Event::Kind::Reduce, slot);
+        return;
+    }
+
+    /// Order loses time priority and is moved to the back of the new price level keeping its slot and ID link
+    unlinkOrder(slot);
+    Order order = _orders.restore(slot);
+    order.amend(newPrice, newQuantity);
+
+    auto isFullyExecuted = not _auctionMode && tryExecute(order);
+    if (isFullyExecuted)
+        removeOrder(slot);
+    else
+    {
+        _orders.hot (slot).quantity = order.getQuantity();
+        _orders.cold(slot).price    = order.getPrice();
+        placeOrder(slot);
+    }
+
+    assert( checkConsistency() );
+    releaseTriggeredStops();
+}
+
+std::pair<bool, Order> OrderBook::findOrderById(Order::IdType id) const
+{
+    auto slot = _idIndex.find(id);
+    if (slot == OrderPool::InvalidSlot)
+        return std::make_pair( false, Order::makeEmptyOrder() );
+    return std::make_pair( true, _orders.restore(slot) );
 }
 
 Order OrderBook::getOrderById(Order::IdType id) const
 {
-    auto orderLink = findOrder(id);
-    return *(orderLink->second);
+    auto orderPair = findOrderById(id);
+    if (!orderPair.first)
+        throwOrderNotFound(id);
+    return orderPair.second;
+}
+
+std::pair<bool, Order> OrderBook::findOrderById(const OrderHandle& handle) const
+{
+    auto slot = resolve(handle);
+    if (slot == OrderPool::InvalidSlot)
+        return std::make_pair( false, Order::makeEmptyOrder() );
+    return std::make_pair( true, _orders.restore(slot) );
+}
+
+Order OrderBook::getOrderById(const OrderHandle& handle) const
+{
+    auto orderPair = findOrderById(handle);
+    if (!orderPair.first)
+        throwOrderNotFound(handle.id);
+    return orderPair.second;
+}
+
+/**
+ *  @return Number of best price levels limited by levelLimit, -1 means all levels
+ */
+static size_t limitLevels(const PriceLevels& levels,
+                          int                levelLimit)
+{
+    return levelLimit < 0 ? levels.size() : std::min( levels.size(), static_cast<size_t>(levelLimit) );
+}
+
+uint64_t OrderBook::getDepthQuantity(Order::Type type,
+                                     int         levelLimit) const
+{
+    const auto& sideLevels = levels(type);
+    auto count = limitLevels(sideLevels, levelLimit);
+    return DepthKernels::sum( sideLevels.quantities() + sideLevels.size() - count, count );
+}
+
+void OrderBook::getCumulativeDepth(Order::Type            type,
+                                   int                    levelLimit,
+                                   std::vector<uint64_t>& depth) const
+{
+    const auto& sideLevels = levels(type);
+    auto count = limitLevels(sideLevels, levelLimit);
+    depth.resize(count);
+    DepthKernels::cumulativeFromBack( sideLevels.quantities() + sideLevels.size() - count, count, depth.data() );
+}
+
+void OrderBook::getPriceLevels(Order::Type                 type,
+                               int                         levelLimit,
+                               std::vector<PricePosition>& positions) const
+{
+    const auto& sideLevels = levels(type);
+    auto count = limitLevels(sideLevels, levelLimit);
+    positions.resize(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        auto level = sideLevels.best() - i;
+        positions[i].price    = sideLevels.price   (level);
+        positions[i].quantity = sideLevels.quantity(level);
+    }
+}
+
+void OrderBook::getQueuedOrders(Order::Type               type,
+                                int                       levelLimit,
+                                std::vector<QueuedOrder>& orders) const
+{
+    const auto& sideLevels = levels(type);
+    auto count = limitLevels(sideLevels, levelLimit);
+    orders.clear();
+    for (size_t i = 0; i < count; ++i)
+    {
+        auto level = sideLevels.best() - i;
+        uint32_t queuePosition = 0;
+        for (auto slot = sideLevels.queue(level).head; slot != OrderPool::InvalidSlot; slot = _orders.hot(slot).next)
+        {
+            QueuedOrder order;
+            order.id            = _orders.cold(slot).id;
+            order.price         = sideLevels.price(level);
+            order.quantity      = _orders.hot(slot).quantity;
+            order.queuePosition = queuePosition++;
+            orders.push_back(order);
+        }
+    }
 }
 
-OrderBook::PriceAggregator::PriceAggregator(OrderContainerIterator startPos,
-                                            OrderContainerIterator endPos)
-    : _curPos(startPos)
-    , _endPos(endPos)
+OrderBook::FillEstimate OrderBook::estimateFill(Order::Type type,
+                                                uint64_t    quantity) const
+{
+    const auto& levels = oppositeLevels(type);
+    FillEstimate estimate;
+    for (auto level = levels.size(); level-- > 0 && estimate.quantity < quantity;)
+    {
+        auto levelQuantity = std::min<uint64_t>( levels.quantity(level), quantity - estimate.quantity );
+        estimate.quantity += levelQuantity;
+        estimate.notional += static_cast<int64_t>(levelQuantity) * levels.price(level);
+    }
+    return estimate;
+}
+
+OrderBook::FillEstimate OrderBook::estimateFillUpToPrice(Order::Type      type,
+                                                         Order::PriceType price) const
+{
+    const auto& levels = oppositeLevels(type);
+    FillEstimate estimate;
+    for (auto level = levels.size() - levels.crossingCount(price); level < levels.size(); ++level)
+    {
+        estimate.quantity += levels.quantity(level);
+        estimate.notional += static_cast<int64_t>( levels.quantity(level) ) * levels.price(level);
+    }
+    return estimate;
+}
+
+OrderBook::PriceAggregator::PriceAggregator(const PriceLevels& levels)
+    : _levels   (levels)
+    , _remaining(levels.size())
 {}
 
 std::pair<bool, OrderBook::PricePosition> OrderBook::PriceAggregator::nextPrice()
 {
     PricePosition pricePosition;
 
-    if (_curPos == _endPos)  // End of container
+    if (_remaining == 0)  // End of container
         return std::make_pair(false, pricePosition);
 
-    pricePosition.price    = _curPos->getPrice();
-    pricePosition.quantity = _curPos->getQuantity();
-
-    while (++_curPos != _endPos && _curPos->getPrice() == pricePosition.price)
-        pricePosition.quantity += _curPos->getQuantity();
+    --_remaining;
+    pricePosition.price    = _levels.price   (_remaining);
+    pricePosition.quantity = _levels.quantity(_remaining);
 
     return std::make_pair(true, pricePosition);
 }
 
+std::pair<bool, OrderBook::PricePosition> OrderBook::getBestPrice(Order::Type type) const
+{
+    return makePriceAggregator(type).nextPrice();
+}
+
 OrderBook::PriceAggregator OrderBook::makePriceAggregator(Order::Type type) const
 {
-    if (type == Order::Type::Ask)
-        return { _askQueue.cbegin(), _askQueue.cend() };
-    else  // Order::Type::Bid
-        return { _bidQueue.cbegin(), _bidQueue.cend() };
+    return PriceAggregator( levels(type) );
 }
 
 void outputOrdersJson(std::ostream&               outStr,
@@ -283,12 +985,46 @@ void OrderBook::marketDataL1JsonInternal(std::ostream& outStr,
     }
 }
 
-std::string OrderBook::marketDataL1JsonSnapshot() const
+void OrderBook::setStatisticsWindow(size_t windowSize)
+{
+    _rollingTradeStatistics = RollingTradeStatistics(windowSize);
+}
+
+void OrderBook::resetTradeStatistics()
+{
+    _tradeStatistics = TradeStatistics();
+    setStatisticsWindow( _rollingTradeStatistics.getWindowSize() );
+}
+
+static void outputTradeStatisticsJson(std::ostream&          outStr,
+                                      const char*            name,
+                                      const TradeStatistics& statistics)
+{
+    outStr  << R"V(,
+    ")V" << name << R"V(": {
+        "open": )V"        << statistics.open       << R"V(,
+        "high": )V"        << statistics.high       << R"V(,
+        "low": )V"         << statistics.low        << R"V(,
+        "close": )V"       << statistics.close      << R"V(,
+        "volume": )V"      << statistics.volume     << R"V(,
+        "notional": )V"    << statistics.notional   << R"V(,
+        "vwap": )V"        << std::fixed << std::setprecision(4) << statistics.vwap() << R"V(,
+        "trade_count": )V" << statistics.tradeCount << R"V(
+    })V";
+}
+
+std::string OrderBook::marketDataL1JsonSnapshot(bool withStatistics) const
 {
     std::ostringstream outStr;
     outStr << '{';
     bool nextComma = false;
     marketDataL1JsonInternal(outStr, nextComma);
+    if (withStatistics && _tradeStatistics.tradeCount > 0)  // last_transaction precedes statistics
+    {
+        outputTradeStatisticsJson(outStr, "statistics", _tradeStatistics);
+        if ( _rollingTradeStatistics.getWindowSize() > 0 )
+            outputTradeStatisticsJson(outStr, "rolling_statistics", _rollingTradeStatistics.get());
+    }
     outStr << std::endl << '}' << std::endl;
     return outStr.str();
 }
@@ -1,10 +1,16 @@
 #pragma once
 
 #include <functional>
-#include <map>
-#include <set>
+#include <vector>
 
 #include "Order.h"
+#include "OrderIndex.h"
+#include "OrderPool.h"
+#include "OwnerLists.h"
+#include "PriceLevels.h"
+#include "StopOrders.h"
+#include "TimingWheel.h"
+#include "TradeStatistics.h"
 #include "NotFoundException.h"
 
 class OrderBook
@@ -15,16 +21,156 @@ public:
      */
     using OrderCallback = std::function<void (Order)>;
 
+    /**
+     *  @brief Callback type for orders canceled together
+     */
+    using OrderBatchCallback = std::function<void (const std::vector<Order>&)>;
+
+    /**
+     *  @brief Result of non-throwing cancellation
+     */
+    enum class CancelStatus
+    {
+        Canceled,
+        NotFound
+    };
+
+    /**
+     *  @brief Quantity and exact notional (sum of price * quantity) available to incoming order
+     *
+     *  @details Average execution price is notional / quantity
+     */
+    struct FillEstimate
+    {
+        uint64_t quantity = 0;
+        int64_t  notional = 0;
+    };
+
+    /**
+     *  @brief Direct reference to resting order: its storage slot and slot generation
+     *
+     *  @details Handle reaches the order with one array index instead of ID lookup.
+     *           It becomes stale once the order leaves the book, stale handles are detected safely
+     */
+    struct OrderHandle
+    {
+        Order::IdType         id         = 0;
+        OrderPool::SlotIndex  slot       = OrderPool::InvalidSlot;  ///< InvalidSlot in case the order did not rest on add
+        OrderPool::Generation generation = 0;
+    };
+
+    /**
+     *  @brief Price and total quantity of price level or transaction
+     */
+    struct PricePosition
+    {
+        Order::PriceType         price    = 0;
+        Order::TotalQuantityType quantity = 0;
+    };
+
+    /**
+     *  @brief Resting order as in L3 market data
+     */
+    struct QueuedOrder
+    {
+        Order::IdType       id            = 0;
+        Order::PriceType    price         = 0;
+        Order::QuantityType quantity      = 0;
+        uint32_t            queuePosition = 0;  ///< 0 for the first order of the price level
+    };
+
+    /**
+     *  @brief Change of a resting order as in L3 market data
+     *
+     *  @details Amend which loses priority is reported as Remove followed by Add with the same ID
+     */
+    struct L3Event
+    {
+        enum class Kind : uint8_t
+        {
+            Add,     ///< Order is placed to the back of its price level
+            Reduce,  ///< Order keeps its place with less quantity
+            Remove   ///< Order leaves the book, quantity is 0
+        };
+
+        uint64_t            sequence = 0;  ///< Sequence of L3 events of the book, starts from 1
+        Kind                kind     = Kind::Add;
+        Order::Type         type     = Order::Type::Bid;
+        Order::IdType       id       = 0;
+        Order::PriceType    price    = 0;
+        Order::QuantityType quantity = 0;  ///< Resting quantity after the change
+    };
+
+    /**
+     *  @brief Callback type for L3 events
+     */
+    using L3EventCallback = std::function<void (const L3Event&)>;
+
+    /**
+     *  @brief One price level of mass quote
+     */
+    struct Quote
+    {
+        Order::Type         type     = Order::Type::Bid;
+        Order::PriceType    price    = 0;
+        Order::QuantityType quantity = 0;  ///< 0 means no order at this level
+    };
+
+    /**
+     *  @brief What mass quote did with resting orders of the quoter
+     */
+    struct MassQuoteResult
+    {
+        size_t kept     = 0;  ///< Orders left as they were
+        size_t amended  = 0;  ///< Orders at the same price with new quantity, keeping their IDs
+        size_t added    = 0;  ///< New orders, including ones executed on entry
+        size_t canceled = 0;  ///< Orders at prices which are not quoted anymore
+    };
+
+    /**
+     *  @brief Clearing price and executed quantity of call auction, zero quantity means the book is not crossed
+     */
+    struct AuctionResult
+    {
+        Order::PriceType price    = 0;
+        uint64_t         quantity = 0;
+    };
+
     /**
      *  @brief Explicitly create order book
      *
      *  @param executedOrderCallback std::function which accepts executed orders
      *  @param canceledOrderCallback std::function which accepts canceled orders
+     *  @param canceledBatchCallback std::function which accepts orders canceled by mass cancel
+     *  @param arena                 Memory of order slots, price levels and ID index, it must outlive the book
+     *
+     *  @details Parameters may be nullptr. Orders canceled by mass cancel are passed to
+     *           canceledOrderCallback one by one in case canceledBatchCallback is empty.
+     *           Storage uses the default heap in case arena is nullptr
+     */
+    explicit OrderBook(OrderCallback      executedOrderCallback = nullptr,
+                       OrderCallback      canceledOrderCallback = nullptr,
+                       OrderBatchCallback canceledBatchCallback = nullptr,
+                       MemoryArena*       arena                 = nullptr);
+
+    /**
+     *  @brief Independent copy of the book for what-if simulation
+     *
+     *  @details Storage is index based, so the copy shares nothing with this book and handles of this book
+     *           resolve to the same orders in the copy. Callbacks are not copied, the copy gets its own ones.
+     *           The copy keeps its storage on the default heap even if this book uses an arena
+     */
+    OrderBook clone(OrderCallback      executedOrderCallback = nullptr,
+                    OrderCallback      canceledOrderCallback = nullptr,
+                    OrderBatchCallback canceledBatchCallback = nullptr) const;
+
+    /**
+     *  @brief Replace state of this book with the state of other book keeping own callbacks
      *
-     *  @details Parameters may be nullptr
+     *  @details Reuses already allocated storage, so forking the same scratch book repeatedly does not allocate.
+     *           Storage stays in the arena of this book
      */
-    explicit OrderBook(OrderCallback executedOrderCallback = nullptr,
-                       OrderCallback canceledOrderCallback = nullptr);
+    void copyStateFrom(const OrderBook& other);
 
     /**
      *  @brief Add order to order book
@@ -32,12 +178,108 @@ public:
      *  @param type     Order type
      *  @param price    Order price
      *  @param quantity Order quantity
+     *  @param owner    Owner (client session) of the order
+     *  @param expiry   Time the order expires at, Order::NoExpiry for good till cancel order
      *
-     *  @details Type can be either Order::Type::Bid or Order::Type::Ask
+     *  @details Type can be either Order::Type::Bid or Order::Type::Ask. IDs are 1, 2, 3 and so on in every book.
+     *           The rest of order with expiry not later than the book time is canceled instead of placed
      */
     Order::IdType addOrder(Order::Type         type,
                            Order::PriceType    price,
-                           Order::QuantityType quantity);
+                           Order::QuantityType quantity,
+                           Order::OwnerType    owner  = Order::NoOwner,
+                           Order::TimeType     expiry = Order::NoExpiry);
+
+    /**
+     *  @brief Add order to order book and get its handle
+     *
+     *  @see addOrder
+     */
+    OrderHandle addOrderWithHandle(Order::Type         type,
+                                   Order::PriceType    price,
+                                   Order::QuantityType quantity,
+                                   Order::OwnerType    owner  = Order::NoOwner,
+                                   Order::TimeType     expiry = Order::NoExpiry);
+
+    /**
+     *  @brief Add stop order which becomes market order once trade price reaches stop price
+     *
+     *  @param stopPrice Bid stop triggers on trade at stopPrice or higher, ask stop on trade at stopPrice or lower
+     *
+     *  @return Order ID of the same sequence as resting orders, the order keeps it after triggering
+     *
+     *  @details Stop is pending until the next trade reaching stopPrice. Triggered stop executes against
+     *           the opposite side, the rest which cannot be executed is canceled with stop price
+     */
+    Order::IdType addStopOrder(Order::Type         type,
+                               Order::PriceType    stopPrice,
+                               Order::QuantityType quantity,
+                               Order::OwnerType    owner = Order::NoOwner);
+
+    /**
+     *  @brief Add stop-limit order which becomes limit order at price once trade price reaches stop price
+     *
+     *  @see addStopOrder
+     */
+    Order::IdType addStopLimitOrder(Order::Type         type,
+                                    Order::PriceType    stopPrice,
+                                    Order::PriceType    price,
+                                    Order::QuantityType quantity,
+                                    Order::OwnerType    owner = Order::NoOwner);
+
+    /**
+     *  @brief Cancel pending stop order without throwing
+     *
+     *  @return CancelStatus::NotFound in case the stop is not pending, e.g. it is already triggered
+     *
+     *  @details Mass cancels remove resting orders only, pending stops are canceled one by one
+     */
+    CancelStatus tryCancelStopOrder(Order::IdType id);
+
+    /**
+     *  @brief Get pending stop order copy
+     *
+     *  @return Pair of found flag and stop order copy
+     */
+    std::pair<bool, StopOrders::StopOrder> findStopOrderById(Order::IdType id) const { return _stopOrders.find(id); }
+
+    [[nodiscard]] size_t getStopOrderCount() const { return _stopOrders.size(); }
+
+    /**
+     *  @brief Move book time forward and cancel orders expired by now
+     *
+     *  @return Number of expired orders
+     *
+     *  @details Expired orders are reported as one mass cancel batch ordered by expiry.
+     *           Takes time proportional to the number of expired orders. Time units are chosen by caller
+     */
+    size_t advanceTime(Order::TimeType now);
+
+    [[nodiscard]] Order::TimeType getTime() const { return _timingWheel.getTime(); }
+
+    /**
+     *  @brief Start call auction
+     *
+     *  @details Added and amended orders are placed to book without matching until uncross() is called
+     */
+    void startAuction();
+
+    [[nodiscard]] bool isAuctionMode() const { return _auctionMode; }
+
+    /**
+     *  @brief Clearing price the auction would uncross at now
+     *
+     *  @details The price maximizes executed quantity, then minimizes surplus, then is the closest to the
+     *           last transaction price, then the lowest one. Takes one pass over crossed price levels
+     */
+    AuctionResult getIndicativeAuctionResult() const;
+
+    /**
+     *  @brief Execute all crossed quantity at the single clearing price and return to continuous matching
+     *
+     *  @details Orders are executed in price/time priority, executed order callbacks come in bid/ask pairs
+     */
+    AuctionResult uncross();
 
     /**
      *  @brief Cancel order
@@ -48,6 +290,103 @@ public:
      */
     void cancelOrder(Order::IdType id);
 
+    /**
+     *  @brief Cancel order without throwing
+     *
+     *  @param id Order ID
+     *
+     *  @return CancelStatus::NotFound in case the order cannot be found
+     *
+     *  @details Miss path neither throws nor allocates, so it suits cancels racing with fills
+     */
+    CancelStatus tryCancelOrder(Order::IdType id);
+
+    /**
+     *  @brief Cancel order by handle
+     *
+     *  @throws NotFoundException Thrown in case the handle is stale
+     */
+    void cancelOrder(const OrderHandle& handle);
+
+    /**
+     *  @brief Cancel order by handle without throwing
+     *
+     *  @return CancelStatus::NotFound in case the handle is stale
+     */
+    CancelStatus tryCancelOrder(const OrderHandle& handle);
+
+    /**
+     *  @brief Cancel all orders of owner including pending stops, e.g. on client disconnect
+     *
+     *  @return Number of canceled orders
+     *
+     *  @details Takes time linear in the number of the owner orders and of pending stops of all owners.
+     *           Stops are reported after resting orders in the same batch
+     */
+    size_t cancelAllForOwner(Order::OwnerType owner);
+
+    /**
+     *  @brief Cancel all orders of the book
+     *
+     *  @return Number of canceled orders
+     */
+    size_t cancelAllOrders();
+
+    /**
+     *  @brief Cancel all orders of one side
+     *
+     *  @return Number of canceled orders
+     */
+    size_t cancelOrders(Order::Type type);
+
+    /**
+     *  @brief Cancel orders of one side with price in range [minPrice, maxPrice]
+     *
+     *  @return Number of canceled orders
+     *
+     *  @details Whole price levels are released at once, takes time proportional to the number of canceled orders
+     */
+    size_t cancelOrders(Order::Type      type,
+                        Order::PriceType minPrice,
+                        Order::PriceType maxPrice);
+
+    /**
+     *  @brief Replace all resting orders of owner with quotes in one call
+     *
+     *  @param owner  Quoter, not Order::NoOwner
+     *  @param quotes New levels of both sides
+     *  @param ids    Output, order ID of every quote or 0 for zero quantity, capacity is reused
+     *
+     *  @details Resting order of owner at the side and price of a quote is reused for it: the same quantity
+     *           keeps it untouched, less quantity reduces it in place, both keep time priority, more quantity
+     *           moves it to the back of its level. Orders at prices not quoted anymore are canceled and reported
+     *           as one mass cancel batch, then quotes without resting order are added and may execute.
+     *           Takes time proportional to the owner orders times quotes, so it suits tens of levels
+     *
+     *  @note Only cancels are batched. Added quotes enter one by one as addOrder does and their executions
+     *        are reported order by order, stops triggered by them are released once after all quotes
+     */
+    MassQuoteResult massQuote(Order::OwnerType            owner,
+                              const std::vector<Quote>&   quotes,
+                              std::vector<Order::IdType>& ids);
+
+    /**
+     *  @brief Amend resting order keeping its ID
+     *
+     *  @param id          Order ID
+     *  @param newPrice    New order price
+     *  @param newQuantity New order quantity
+     *
+     *  @throws NotFoundException Thrown in case the order cannot be found
+     *
+     *  @details Quantity decrease at the same price is done in place and keeps time priority.
+     *           Price change or quantity increase moves the order to the back of the new price level
+     *           and may execute it against the opposite side. Zero quantity cancels the order. Expiry is kept.
+     */
+    void amendOrder(Order::IdType       id,
+                    Order::PriceType    newPrice,
+                    Order::QuantityType newQuantity);
+
     /**
      *  @brief Get order copy
      *
@@ -59,6 +398,27 @@ public:
      */
     Order getOrderById(Order::IdType id) const;
 
+    /**
+     *  @brief Get order copy without throwing
+     *
+     *  @param id Order ID
+     *
+     *  @return Pair of found flag and order copy, the order is empty in case it cannot be found
+     */
+    std::pair<bool, Order> findOrderById(Order::IdType id) const;
+
+    /**
+     *  @brief Get order copy by handle
+     *
+     *  @throws NotFoundException Thrown in case the handle is stale
+     */
+    Order getOrderById(const OrderHandle& handle) const;
+
+    /**
+     *  @brief Get order copy by handle without throwing
+     */
+    std::pair<bool, Order> findOrderById(const OrderHandle& handle) const;
+
     /**
      *  @brief Order book information in JSON format
      *
@@ -70,10 +430,140 @@ public:
     std::string getOrderBookInfoJson(int bidOrderLimit = -1,
                                      int askOrderLimit = -1) const;
 
+    /**
+     *  @brief Total quantity of the best price levels
+     *
+     *  @param type       Order book side
+     *  @param levelLimit Max number of price levels
+     *
+     *  @details -1 means all price levels
+     */
+    uint64_t getDepthQuantity(Order::Type type,
+                              int         levelLimit = -1) const;
+
+    /**
+     *  @brief Cumulative quantities of the best price levels
+     *
+     *  @param type       Order book side
+     *  @param levelLimit Max number of price levels
+     *  @param depth      Output, depth[i] is total quantity of i + 1 best price levels
+     *
+     *  @details -1 means all price levels. Capacity of depth is reused between calls
+     */
+    void getCumulativeDepth(Order::Type            type,
+                            int                    levelLimit,
+                            std::vector<uint64_t>& depth) const;
+
+    /**
+     *  @brief The best price levels of one side
+     *
+     *  @param type       Order book side
+     *  @param levelLimit Max number of price levels
+     *  @param positions  Output, the best level is the first one
+     *
+     *  @details -1 means all price levels. Capacity of positions is reused between calls
+     */
+    void getPriceLevels(Order::Type                 type,
+                        int                         levelLimit,
+                        std::vector<PricePosition>& positions) const;
+
+    /**
+     *  @brief Resting orders of one side in priority order as in L3 market data
+     *
+     *  @param type       Order book side
+     *  @param levelLimit Max number of price levels
+     *  @param orders     Output, orders of the best level go first, every level in queue order
+     *
+     *  @details -1 means all price levels. Walks level queues directly, capacity of orders is reused
+     */
+    void getQueuedOrders(Order::Type               type,
+                         int                       levelLimit,
+                         std::vector<QueuedOrder>& orders) const;
+
+    /**
+     *  @brief Set callback of L3 events emitted by every change of resting orders, nullptr stops them
+     *
+     *  @details Snapshot taken by getQueuedOrders reflects events up to getL3Sequence(), the callback is not
+     *           copied by clone and copyStateFrom
+     */
+    void setL3Callback(L3EventCallback callback) { _l3Callback = std::move(callback); }
+
+    [[nodiscard]] uint64_t getL3Sequence() const { return _l3Sequence; }
+
+    /**
+     *  @brief Cost to fill incoming order of given quantity by the best prices of the opposite side
+     *
+     *  @param type     Incoming order type
+     *  @param quantity Quantity to fill
+     *
+     *  @return Filled quantity may be less than requested in case the opposite side has not enough liquidity
+     *
+     *  @details Takes time proportional to the number of crossed price levels
+     */
+    FillEstimate estimateFill(Order::Type type,
+                              uint64_t    quantity) const;
+
+    /**
+     *  @brief Quantity and notional available to incoming order up to its limit price
+     *
+     *  @param type  Incoming order type
+     *  @param price Incoming order limit price
+     *
+     *  @details Takes time proportional to the number of crossed price levels
+     */
+    FillEstimate estimateFillUpToPrice(Order::Type      type,
+                                       Order::PriceType price) const;
+
+    /**
+     *  @brief The best price level of one side as in L1 market data
+     *
+     *  @return Pair of flag whether the side has orders and the level
+     */
+    std::pair<bool, PricePosition> getBestPrice(Order::Type type) const;
+
+    /**
+     *  @brief Price and quantity of the last transaction as in L1 market data
+     *
+     *  @return Pair of flag whether any transaction happened and the transaction
+     */
+    std::pair<bool, PricePosition> getLastTransaction() const
+    {
+        PricePosition transaction;
+        transaction.price    = _lastPrice;
+        transaction.quantity = _lastQuantity;
+        return std::make_pair(_haveTransactionsStarted, transaction);
+    }
+
+    /**
+     *  @brief Statistics of all trades since the book creation or the last reset
+     */
+    const TradeStatistics& getTradeStatistics() const { return _tradeStatistics; }
+
+    /**
+     *  @brief Statistics of the last trades
+     *
+     *  @see setStatisticsWindow
+     */
+    TradeStatistics getRollingTradeStatistics() const { return _rollingTradeStatistics.get(); }
+
+    /**
+     *  @brief Set number of the last trades accounted by rolling statistics, 0 disables them
+     *
+     *  @details Rolling statistics are restarted
+     */
+    void setStatisticsWindow(size_t windowSize);
+
+    /**
+     *  @brief Start new session of trade statistics
+     */
+    void resetTradeStatistics();
+
     /**
      *  @brief Market data L1 in JSON format
+     *
+     *  @param withStatistics Include trade statistics
      */
-    std::string marketDataL1JsonSnapshot() const;
+    std::string marketDataL1JsonSnapshot(bool withStatistics = false) const;
 
     /**
      *  @brief Market data L2 in JSON format
@@ -82,38 +572,38 @@ public:
                                          int askOrderLimit = -1) const;
 
 private:
-    struct AskOrderSort
-    {
-        bool operator ()(const Order& o1,
-                         const Order& o2) const
-        {
-            return o1.getPrice() < o2.getPrice() ||
-                   o1.getPrice() == o2.getPrice() && o1.getId() < o2.getId();
-        }
-    };
-    struct BidOrderSort
-    {
-        bool operator ()(const Order& o1,
-                         const Order& o2) const
-        {
-            return o1.getPrice() > o2.getPrice() ||
-                   o1.getPrice() == o2.getPrice() && o1.getId() < o2.getId();
-        }
-    };
-    using OrderContainerAsk      = std::set<Order, AskOrderSort>;
-    using OrderContainerBid      = std::set<Order, BidOrderSort>;
-    using OrderContainerIterator = std::set<Order>::iterator;
-    using IdOrderLink            = std::map<Order::IdType, OrderContainerIterator>;
-
-    OrderContainerAsk   _askQueue;
-    OrderContainerBid   _bidQueue;
-    IdOrderLink         _idOrderLink;
+    OrderPool           _orders;
+    PriceLevels         _askLevels;
+    PriceLevels         _bidLevels;
+    OrderIndex          _idIndex;
+    OwnerLists          _ownerLists;
+    TimingWheel         _timingWheel;
+    StopOrders          _stopOrders;
     OrderCallback       _executedOrderCallback;
     OrderCallback       _canceledOrderCallback;
+    OrderBatchCallback  _canceledBatchCallback;
+    std::vector<Order>  _canceledBatch;  ///< Buffer of mass cancel, capacity is reused
+    L3EventCallback     _l3Callback;
+    uint64_t            _l3Sequence;     ///< Counts changes even without callback, so snapshots are sequenced
+
+    std::vector<OrderPool::SlotIndex>  _expiredSlots;  ///< Buffer of advanceTime, capacity is reused
+    std::vector<OrderPool::SlotIndex>  _quoteSlots;    ///< Buffer of massQuote: resting order reused by each quote
+    std::vector<StopOrders::StopOrder> _ownerStops;    ///< Buffer of cancelAllForOwner, capacity is reused
+
+    bool                     _haveTransactionsStarted;
+    Order::PriceType         _lastPrice;
+    Order::TotalQuantityType _lastQuantity;  ///< Trades in a row at the same price are summed
 
-    bool                _haveTransactionsStarted;
-    Order::PriceType    _lastPrice;
-    Order::QuantityType _lastQuantity;
+    /// Range of trade prices which triggered stops since the last release, empty when _triggerLow > _triggerHigh
+    Order::PriceType    _triggerLow;
+    Order::PriceType    _triggerHigh;
+
+    bool                _auctionMode;
+
+    Order::IdType       _nextOrderId;  ///< Order IDs are sequential per book, so independent books may run in parallel
+
+    TradeStatistics        _tradeStatistics;
+    RollingTradeStatistics _rollingTradeStatistics;
 
     /**
      *  @brief Helper method, sets _executedOrderCallback (if it is not empty) with given order
@@ -129,34 +619,118 @@ private:
      */
     bool tryExecute(Order &order);
 
-    using CompareOrderFunction = std::function<bool (Order::PriceType, Order::PriceType)>;
-    template <typename Container>
-    bool tryExecute(Order&                      order,
-                    Container&                  container,
-                    const CompareOrderFunction& possibleExecution);
+    bool tryExecute(Order&       order,
+                    PriceLevels& levels);
 
-    bool checkConsistency() const;
+    /**
+     *  @brief Execute quantity of resting order at executionPrice, fully executed order is removed from book
+     *
+     *  @note Empty price level is not erased
+     */
+    void executeRestingOrder(PriceLevels&            levels,
+                             PriceLevels::LevelIndex level,
+                             OrderPool::SlotIndex    slot,
+                             Order::QuantityType     quantity,
+                             Order::PriceType        executionPrice);
 
     /**
-     *  @throws NotFoundException Thrown in case the order cannot be found
+     *  @brief Remove orders of levels [first, last) from book and collect them to _canceledBatch
+     *
+     *  @param releaseSlots false in case the whole storage is cleared afterwards, IDs are erased from the index anyway
+     *
+     *  @return Number of removed orders
      */
-    IdOrderLink::const_iterator findOrder(Order::IdType id) const;
+    size_t removeLevels(PriceLevels&            levels,
+                        PriceLevels::LevelIndex first,
+                        PriceLevels::LevelIndex last,
+                        bool                    releaseSlots);
 
-    struct PricePosition
+    /**
+     *  @brief Pass _canceledBatch to callbacks and clear it
+     */
+    void sendCanceledBatch();
+
+    /**
+     *  @brief Account trade in last transaction and trade statistics
+     */
+    void updateMarketData(Order::PriceType    executionPrice,
+                          Order::QuantityType executionQuantity);
+
+    /**
+     *  @brief Match incoming order and place its rest to book unless it is expired
+     */
+    OrderHandle enterOrder(Order&          order,
+                           Order::TimeType expiry);
+
+    /**
+     *  @brief Enter triggered stops one by one until trades they cause trigger no more stops
+     */
+    void releaseTriggeredStops();
+
+    /**
+     *  @brief Count change of resting order kept in slot and pass it to _l3Callback
+     */
+    void publishL3(L3Event::Kind        kind,
+                   OrderPool::SlotIndex slot)
     {
-        Order::PriceType    price    = 0;
-        Order::QuantityType quantity = 0;
-    };
+        ++_l3Sequence;
+        if (_l3Callback)
+            sendL3(kind, slot);
+    }
+
+    void sendL3(L3Event::Kind        kind,
+                OrderPool::SlotIndex slot);
+
+    /**
+     *  @brief Place the rest of incoming order to the back of its price level
+     */
+    void placeOrder(OrderPool::SlotIndex slot);
+
+    /**
+     *  @return Slot of the order or OrderPool::InvalidSlot in case the handle is stale or its ID is not the order's one
+     */
+    OrderPool::SlotIndex resolve(const OrderHandle& handle) const;
+
+    /**
+     *  @brief Notify canceled order callback, remove order from book and release its slot
+     */
+    void cancelSlot(OrderPool::SlotIndex slot);
+
+    /**
+     *  @brief Remove order from ID index, owner list and timing wheel and release its slot
+     *
+     *  @note The order must be already unlinked from its price level
+     */
+    void removeOrder(OrderPool::SlotIndex slot);
+
+    /**
+     *  @brief Unlink order from its price level and erase the level in case it becomes empty
+     */
+    void unlinkOrder(OrderPool::SlotIndex slot);
+
+    PriceLevels&       levels(Order::Type type)       { return type == Order::Type::Ask ? _askLevels : _bidLevels; }
+    const PriceLevels& levels(Order::Type type) const { return type == Order::Type::Ask ? _askLevels : _bidLevels; }
+
+    /**
+     *  @return Price levels which execute incoming order of given type
+     */
+    const PriceLevels& oppositeLevels(Order::Type type) const { return type == Order::Type::Bid ? _askLevels : _bidLevels; }
+
+    bool checkConsistency() const;
+
+    /**
+     *  @throws NotFoundException Thrown in case the order cannot be found
+     */
+    OrderPool::SlotIndex findOrder(Order::IdType id) const;
 
     class PriceAggregator
     {
     public:
-        PriceAggregator(OrderContainerIterator startPos,
-                        OrderContainerIterator endPos);
+        explicit PriceAggregator(const PriceLevels& levels);
         std::pair<bool, PricePosition> nextPrice();
     private:
-        OrderContainerIterator       _curPos;
-        const OrderContainerIterator _endPos;
+        const PriceLevels& _levels;
+        size_t             _remaining;  ///< Number of levels left, the next level index is _remaining - 1
     };
 
     PriceAggregator makePriceAggregator(Order::Type type) const;
@@ -0,0 +1,234 @@
+#include "OrderGateway.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+static constexpr uint64_t GatewayMagic = 0x4f42474154455741;  // "OBGATEWA"
+
+/**
+ *  @brief Layout of client shared memory object: header, request queue, response queue
+ */
+struct alignas(64) GatewayHeader
+{
+    std::atomic<uint64_t> magic;  ///< Written the last by the gateway
+    uint32_t              capacity;
+};
+
+static uint32_t roundUpToPowerOfTwo(uint32_t value)
+{
+    uint32_t result = 1;
+    while (result < value)
+        result <<= 1;
+    return result;
+}
+
+static size_t gatewaySize(uint32_t capacity)
+{
+    return sizeof(GatewayHeader) +
+           SharedQueue<GatewayRequest> ::memorySize(capacity) +
+           SharedQueue<GatewayResponse>::memorySize(capacity);
+}
+
+static void* requestQueueMemory(const SharedMemory& memory)
+{
+    return static_cast<char*>( memory.data() ) + sizeof(GatewayHeader);
+}
+
+static void* responseQueueMemory(const SharedMemory& memory,
+                                 uint32_t            capacity)
+{
+    return static_cast<char*>( requestQueueMemory(memory) ) + SharedQueue<GatewayRequest>::memorySize(capacity);
+}
+
+std::string OrderGateway::clientName(const std::string& prefix,
+                                     uint32_t           client)
+{
+    return prefix + '_' + std::to_string(client);
+}
+
+OrderGateway::OrderGateway(const std::string& prefix,
+                           uint32_t           clientCount,
+                           uint32_t           capacity,
+                           uint32_t           pendingLimit)
+    : _orderBook   ( [this](Order order) { respond(order, GatewayResponse::Kind::Executed); },
+                     [this](Order order) { respond(order, GatewayResponse::Kind::Canceled); } )
+    , _pendingLimit( std::max<uint32_t>(pendingLimit, 1) )
+    , _currentOwner( Order::NoOwner )
+    , _currentTag  ( 0 )
+{
+    capacity = roundUpToPowerOfTwo(capacity);
+    _clients.reserve(clientCount);
+    for (uint32_t client = 0; client < clientCount; ++client)
+    {
+        auto memory = SharedMemory::create( clientName(prefix, client), gatewaySize(capacity) );
+        SharedQueue<GatewayRequest>  requests ( requestQueueMemory (memory),           capacity );
+        SharedQueue<GatewayResponse> responses( responseQueueMemory(memory, capacity), capacity );
+        auto& header = *static_cast<GatewayHeader*>( memory.data() );
+        header.capacity = capacity;
+        header.magic.store(GatewayMagic, std::memory_order_release);
+        _clients.push_back( Client{std::move(memory), requests, responses, {}} );
+    }
+}
+
+size_t OrderGateway::poll(size_t requestLimit)
+{
+    size_t processed = 0;
+    for (uint32_t client = 0; client < _clients.size(); ++client)
+    {
+        auto& clientState = _clients[client];
+        while ( not clientState.pending.empty() && clientState.responses.tryPush( clientState.pending.front() ) )
+            clientState.pending.pop_front();
+
+        /// Slow consumer: its orders are canceled, so the backlog grows by their Canceled responses only
+        if (clientState.pending.size() >= _pendingLimit)
+        {
+            _orderBook.cancelAllForOwner(client + 1);
+            continue;
+        }
+
+        GatewayRequest request;
+        for (size_t i = 0; i < requestLimit && clientState.requests.tryPop(request); ++i)
+        {
+            process(client, request);
+            ++processed;
+        }
+    }
+    return processed;
+}
+
+/**
+ *  @brief Check fields written by client before they reach the book
+ *
+ *  @return RejectReason::None in case the request may be applied
+ */
+static GatewayResponse::RejectReason validate(const GatewayRequest& request)
+{
+    switch (request.kind)
+    {
+    case GatewayRequest::Kind::Add:
+        if (request.type != Order::Type::Ask && request.type != Order::Type::Bid)
+            return GatewayResponse::RejectReason::Malformed;
+        return request.quantity == 0 ? GatewayResponse::RejectReason::InvalidQuantity : GatewayResponse::RejectReason::None;
+    case GatewayRequest::Kind::Cancel:
+        return request.id == 0 ? GatewayResponse::RejectReason::UnknownOrder : GatewayResponse::RejectReason::None;
+    case GatewayRequest::Kind::Amend:
+        if (request.id == 0)
+            return GatewayResponse::RejectReason::UnknownOrder;
+        return request.quantity == 0 ? GatewayResponse::RejectReason::InvalidQuantity : GatewayResponse::RejectReason::None;
+    }
+    return GatewayResponse::RejectReason::Malformed;  // Kind value out of the enumeration
+}
+
+void OrderGateway::process(uint32_t              client,
+                           const GatewayRequest& request)
+{
+    _currentOwner = client + 1;
+    _currentTag   = request.tag;
+
+    auto reason = validate(request);
+    if (reason != GatewayResponse::RejectReason::None)
+        reject(client, request, reason);
+    else if (request.kind == GatewayRequest::Kind::Add)
+    {
+        auto id = _orderBook.addOrder(request.type, request.price, request.quantity, _currentOwner);
+        GatewayResponse response;
+        response.tag      = request.tag;
+        response.id       = id;
+        response.kind     = GatewayResponse::Kind::Accepted;
+        response.price    = request.price;
+        response.quantity = restingQuantity(id);
+        respond(_currentOwner, response);
+    }
+    else
+    {
+        auto found = _orderBook.findOrderById(request.id);
+        if (not found.first)
+            reject(client, request, GatewayResponse::RejectReason::UnknownOrder);
+        else if (found.second.getOwner() != _currentOwner)
+            reject(client, request, GatewayResponse::RejectReason::NotOwner);
+        else if (request.kind == GatewayRequest::Kind::Cancel)
+            _orderBook.cancelOrder(request.id);  // Canceled response comes from the callback
+        else if (request.kind == GatewayRequest::Kind::Amend)
+        {
+            _orderBook.amendOrder(request.id, request.price, request.quantity);
+            GatewayResponse response;
+            response.tag      = request.tag;
+            response.id       = request.id;
+            response.kind     = GatewayResponse::Kind::Amended;
+            response.price    = request.price;
+            response.quantity = restingQuantity(request.id);
+            respond(_currentOwner, response);
+        }
+    }
+
+    _currentOwner = Order::NoOwner;
+    _currentTag   = 0;
+}
+
+void OrderGateway::respond(Order::OwnerType       owner,
+                           const GatewayResponse& response)
+{
+    if ( owner == Order::NoOwner || owner > _clients.size() )
+        return;  // Order was not entered through the gateway
+
+    auto& client = _clients[owner - 1];
+    if ( not client.pending.empty() || not client.responses.tryPush(response) )
+        client.pending.push_back(response);
+}
+
+void OrderGateway::respond(const Order&          order,
+                           GatewayResponse::Kind kind)
+{
+    GatewayResponse response;
+    response.tag      = order.getOwner() == _currentOwner ? _currentTag : 0;
+    response.id       = order.getId();
+    response.kind     = kind;
+    response.price    = order.getPrice();
+    response.quantity = order.getQuantity();
+    respond(order.getOwner(), response);
+}
+
+void OrderGateway::reject(uint32_t                      client,
+                          const GatewayRequest&         request,
+                          GatewayResponse::RejectReason reason)
+{
+    GatewayResponse response;
+    response.tag      = request.tag;
+    response.id       = request.id;
+    response.kind     = GatewayResponse::Kind::Rejected;
+    response.reason   = reason;
+    response.price    = request.price;
+    response.quantity = request.quantity;
+    respond(client + 1, response);
+}
+
+Order::QuantityType OrderGateway::restingQuantity(Order::IdType id) const
+{
+    auto found = _orderBook.findOrderById(id);
+    return found.first ? found.second.getQuantity() : 0;
+}
+
+static SharedMemory openGateway(const std::string& prefix,
+                                uint32_t           client)
+{
+    auto name = OrderGateway::clientName(prefix, client);
+    auto memory = SharedMemory::open(name, true);
+    const auto& header = *static_cast<const GatewayHeader*>( memory.data() );
+    if ( memory.size() < sizeof(GatewayHeader) ||
+         header.magic.load(std::memory_order_acquire) != GatewayMagic ||
+         memory.size() < gatewaySize(header.capacity) )
+        throw std::runtime_error("Not an order gateway " + name);
+    return memory;
+}
+
+static uint32_t gatewayCapacity(const SharedMemory& memory)
+{
+    return static_cast<const GatewayHeader*>( memory.data() )->capacity;
+}
+
+OrderGatewayClient::OrderGatewayClient(const std::string& prefix,
+                                       uint32_t           client)
+    : _memory   ( openGateway(prefix, client) )
+    , _requests ( requestQueueMemory (_memory),                           gatewayCapacity(_memory) )
+    , _responses( responseQueueMemory(_memory, gatewayCapacity(_memory)), gatewayCapacity(_memory) )
+{}
\ No newline at end of file
@@ -0,0 +1,168 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <vector>
+
+#include "OrderBook.h"
+#include "SharedMemory.h"
+#include "SharedQueue.h"
+
+/**
+ *  @brief Fixed size command of a gateway client
+ */
+struct GatewayRequest
+{
+    enum class Kind : uint8_t
+    {
+        Add,
+        Cancel,
+        Amend
+    };
+
+    uint64_t            tag      = 0;  ///< Chosen by client, echoed in responses to the request
+    Order::IdType       id       = 0;  ///< Cancel and Amend
+    Kind                kind     = Kind::Add;
+    Order::Type         type     = Order::Type::Bid;  ///< Add
+    Order::PriceType    price    = 0;  ///< Add and Amend
+    Order::QuantityType quantity = 0;  ///< Add and Amend, not 0: orders are removed by Cancel
+};
+
+/**
+ *  @brief Fixed size response to a gateway client
+ */
+struct GatewayResponse
+{
+    enum class Kind : uint8_t
+    {
+        Accepted,  ///< Order is added, quantity is the resting one
+        Amended,   ///< Order is amended, quantity is the resting one
+        Executed,  ///< Order of the client is executed by quantity at price
+        Canceled,  ///< Order of the client is canceled, quantity is the canceled one
+        Rejected
+    };
+
+    enum class RejectReason : uint8_t
+    {
+        None,
+        UnknownOrder,
+        NotOwner,
+        InvalidQuantity,
+        Malformed         ///< Unknown request kind or order side
+    };
+
+    uint64_t            tag      = 0;  ///< Tag of the request which caused the response, 0 for passive executions
+    Order::IdType       id       = 0;
+    Kind                kind     = Kind::Accepted;
+    RejectReason        reason   = RejectReason::None;
+    Order::PriceType    price    = 0;
+    Order::QuantityType quantity = 0;
+};
+
+/**
+ *  @brief Order entry front end serving clients on the same host through shared memory
+ *
+ *  @details Every client has its own shared memory object with a request queue and a response queue.
+ *           The matching thread calls poll() which applies requests to the owned order book. Orders
+ *           of client i are added with owner i + 1, so executions of resting orders are routed to their
+ *           clients. Executions of incoming order precede its Accepted or Amended response. Responses
+ *           which do not fit the client queue are kept by the gateway and sent by the next poll().
+ *           A client with pendingLimit kept responses is treated as a slow consumer: its requests wait in its
+ *           request queue, so send() fails once the queue is full, and its orders are canceled, so executions
+ *           cannot grow the backlog further. Requests are processed again once the client reads the backlog.
+ */
+class OrderGateway
+{
+public:
+    /**
+     *  @param prefix       Prefix of shared memory object names starting with '/'
+     *  @param clientCount  Number of clients
+     *  @param capacity     Capacity of each queue, rounded up to a power of two
+     *  @param pendingLimit Max number of responses kept by the gateway for a client before it is a slow consumer
+     */
+    OrderGateway(const std::string& prefix,
+                 uint32_t           clientCount,
+                 uint32_t           capacity,
+                 uint32_t           pendingLimit = 1024);
+
+    OrderGateway(const OrderGateway&) = delete;
+    OrderGateway& operator =(const OrderGateway&) = delete;
+
+    /**
+     *  @brief Process pending requests of all clients
+     *
+     *  @param requestLimit Max number of requests of one client processed, keeps clients fair
+     *
+     *  @return Number of processed requests
+     *
+     *  @details Requests of a slow consumer are not processed
+     */
+    size_t poll(size_t requestLimit = 64);
+
+    [[nodiscard]] const OrderBook& getOrderBook() const { return _orderBook; }
+
+    /**
+     *  @return Name of the shared memory object of client
+     */
+    static std::string clientName(const std::string& prefix,
+                                  uint32_t           client);
+
+private:
+    struct Client
+    {
+        SharedMemory                  memory;
+        SharedQueue<GatewayRequest>   requests;
+        SharedQueue<GatewayResponse>  responses;
+        std::deque<GatewayResponse>   pending;  ///< Responses waiting for room in the queue
+    };
+
+    OrderBook           _orderBook;
+    std::vector<Client> _clients;
+    uint32_t            _pendingLimit;
+    Order::OwnerType    _currentOwner;  ///< Owner of the request being processed
+    uint64_t            _currentTag;
+
+    void process(uint32_t              client,
+                 const GatewayRequest& request);
+
+    void respond(Order::OwnerType       owner,
+                 const GatewayResponse& response);
+
+    void respond(const Order&          order,
+                 GatewayResponse::Kind kind);
+
+    void reject(uint32_t                      client,
+                const GatewayRequest&         request,
+                GatewayResponse::RejectReason reason);
+
+    /**
+     *  @return Resting quantity of the order, 0 in case it is not in the book
+     */
+    Order::QuantityType restingQuantity(Order::IdType id) const;
+};
+
+/**
+ *  @brief Client side of the gateway, lives in the client process
+ */
+class OrderGatewayClient
+{
+public:
+    OrderGatewayClient(const std::string& prefix,
+                       uint32_t           client);
+
+    /**
+     *  @return false in case the request queue is full
+     */
+    bool send(const GatewayRequest& request) { return _requests.tryPush(request); }
+
+    /**
+     *  @return false in case there are no responses
+     */
+    bool poll(GatewayResponse& response) { return _responses.tryPop(response); }
+
+private:
+    SharedMemory                 _memory;
+    SharedQueue<GatewayRequest>  _requests;
+    SharedQueue<GatewayResponse> _responses;
+};
\ No newline at end of file
@@ -0,0 +1,99 @@
+#include "OrderIndex.h"
+
+#include <algorithm>
+
+static constexpr size_t initialCapacity = 16;
+
+OrderIndex::OrderIndex(MemoryArena* arena)
+    : _entries( initialCapacity, Entry{0, OrderPool::InvalidSlot}, ArenaAllocator<Entry>(arena) )
+    , _mask   ( initialCapacity - 1 )
+    , _size   ( 0 )
+{}
+
+size_t OrderIndex::bucket(Order::IdType id) const
+{
+    /// Fibonacci hashing spreads sequential IDs over the whole table
+    return static_cast<size_t>( (id * 0x9E3779B97F4A7C15ull) >> 32 ) & _mask;
+}
+
+OrderPool::SlotIndex OrderIndex::find(Order::IdType id) const
+{
+    if (id == 0)  // Caller supplied ID which never names an order
+        return OrderPool::InvalidSlot;
+    for (auto pos = bucket(id);; pos = (pos + 1) & _mask)
+    {
+        const auto& entry = _entries[pos];
+        if (entry.id == id)
+            return entry.slot;
+        if (entry.id == 0)
+            return OrderPool::InvalidSlot;
+    }
+}
+
+void OrderIndex::insert(Order::IdType        id,
+                        OrderPool::SlotIndex slot)
+{
+    assert(id != 0);
+    if ( (_size + 1) * 2 > _entries.size() )  // Keep load factor not greater than 1/2
+        grow();
+
+    auto pos = bucket(id);
+    while (_entries[pos].id != 0)
+    {
+        assert(_entries[pos].id != id);
+        pos = (pos + 1) & _mask;
+    }
+    _entries[pos] = Entry{id, slot};
+    ++_size;
+}
+
+bool OrderIndex::erase(Order::IdType id)
+{
+    if (id == 0)
+        return false;
+    auto pos = bucket(id);
+    while (_entries[pos].id != id)
+    {
+        if (_entries[pos].id == 0)
+            return false;
+        pos = (pos + 1) & _mask;
+    }
+
+    /// Shift back following entries of the probe sequence to fill the hole
+    auto hole = pos;
+    for (auto next = (hole + 1) & _mask; _entries[next].id != 0; next = (next + 1) & _mask)
+    {
+        auto home = bucket(_entries[next].id);
+        if ( ((next - home) & _mask) >= ((next - hole) & _mask) )
+        {
+            _entries[hole] = _entries[next];
+            hole = next;
+        }
+    }
+    _entries[hole] = Entry{0, OrderPool::InvalidSlot};
+    --_size;
+    return true;
+}
+
+void OrderIndex::clear()
+{
+    std::fill( _entries.begin(), _entries.end(), Entry{0, OrderPool::InvalidSlot} );
+    _size = 0;
+}
+
+void OrderIndex::grow()
+{
+    ArenaVector<Entry> entries( _entries.size() * 2, Entry{0, OrderPool::InvalidSlot}, _entries.get_allocator() );
+    entries.swap(_entries);
+    _mask = _entries.size() - 1;
+
+    for (const auto& entry : entries)
+    {
+        if (entry.id == 0)
+            continue;
+        auto pos = bucket(entry.id);
+        while (_entries[pos].id != 0)
+            pos = (pos + 1) & _mask;
+        _entries[pos] = entry;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "OrderPool.h"
+
+/**
+ *  @brief Open addressing hash table which links order ID to its OrderPool slot
+ *
+ *  @details Linear probing over a flat array, erased entries are backward shifted,
+ *           so there are neither tombstones nor per-entry allocations.
+ *           ID 0 marks an empty entry, valid order IDs start from 1.
+ */
+class OrderIndex
+{
+public:
+    /**
+     *  @param arena Memory of the table, nullptr means the default heap
+     */
+    explicit OrderIndex(MemoryArena* arena = nullptr);
+
+    /**
+     *  @return Slot of the order or OrderPool::InvalidSlot in case the order cannot be found, e.g. for ID 0
+     */
+    [[nodiscard]] OrderPool::SlotIndex find(Order::IdType id) const;
+
+    /**
+     *  @note ID must not be 0
+     */
+    void insert(Order::IdType        id,
+                OrderPool::SlotIndex slot);
+
+    /**
+     *  @return false in case the order cannot be found, e.g. for ID 0
+     */
+    bool erase(Order::IdType id);
+
+    void clear();
+
+    [[nodiscard]] size_t size() const { return _size; }
+
+private:
+    struct Entry
+    {
+        Order::IdType        id;
+        OrderPool::SlotIndex slot;
+    };
+
+    ArenaVector<Entry> _entries;
+    size_t             _mask;
+    size_t             _size;
+
+    [[nodiscard]] size_t bucket(Order::IdType id) const;
+
+    void grow();
+};
\ No newline at end of file
@@ -0,0 +1,77 @@
+#include "OrderPool.h"
+
+constexpr OrderPool::SlotIndex OrderPool::InvalidSlot;
+
+OrderPool::OrderPool(MemoryArena* arena)
+    : _hot     ( ArenaAllocator<HotSlot>  (arena) )
+    , _cold    ( ArenaAllocator<ColdSlot> (arena) )
+    , _owners  ( ArenaAllocator<OwnerSlot>(arena) )
+    , _timers  ( ArenaAllocator<TimerSlot>(arena) )
+    , _freeHead( InvalidSlot )
+    , _size    ( 0 )
+{}
+
+OrderPool::SlotIndex OrderPool::allocate(const Order& order)
+{
+    SlotIndex slot;
+    if (_freeHead != InvalidSlot)
+    {
+        slot = _freeHead;
+        _freeHead = _hot[slot].next;
+    }
+    else
+    {
+        slot = static_cast<SlotIndex>( _hot.size() );
+        assert(slot != InvalidSlot);
+        _hot   .emplace_back();
+        _cold  .emplace_back();
+        _owners.emplace_back();
+        _timers.emplace_back();
+        _cold[slot].generation = 0;
+    }
+
+    assert(order.getQuantity() != 0);
+    _hot   [slot] = HotSlot  { order.getQuantity(), InvalidSlot };
+    _cold  [slot] = ColdSlot { order.getId(), order.getPrice(), InvalidSlot, _cold[slot].generation, order.getType() };
+    _owners[slot] = OwnerSlot{ order.getOwner(), InvalidSlot, InvalidSlot };
+    _timers[slot] = TimerSlot{ Order::NoExpiry, InvalidSlot, InvalidSlot };
+    ++_size;
+    return slot;
+}
+
+void OrderPool::release(SlotIndex slot)
+{
+    assert(_size > 0);
+    _hot[slot].quantity = 0;
+    _hot[slot].next     = _freeHead;
+    ++_cold[slot].generation;
+    _freeHead = slot;
+    --_size;
+}
+
+void OrderPool::clear()
+{
+    /// Slots are kept to preserve their generations, all of them are chained to free list
+    _freeHead = InvalidSlot;
+    for (auto slot = static_cast<SlotIndex>( _hot.size() ); slot-- > 0;)
+    {
+        if (_hot[slot].quantity != 0)
+            ++_cold[slot].generation;
+        _hot[slot].quantity = 0;
+        _hot[slot].next     = _freeHead;
+        _freeHead = slot;
+    }
+    _size = 0;
+}
+
+Order OrderPool::restore(SlotIndex slot) const
+{
+    return restore(slot, _hot[slot].quantity);
+}
+
+Order OrderPool::restore(SlotIndex           slot,
+                         Order::QuantityType quantity) const
+{
+    const auto& cold = _cold[slot];
+    return { cold.type, cold.id, cold.price, quantity, _owners[slot].owner };
+}
\ No newline at end of file
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "MemoryArena.h"
+#include "Order.h"
+
+/**
+ *  @brief Slot storage of resting orders
+ *
+ *  @details Hot matching fields (quantity, next order in the price level) are packed together,
+ *           cold fields are kept in a separate array. Orders are addressed by slot index,
+ *           so the storage has no pointers and released slots are reused via free list.
+ */
+class OrderPool
+{
+public:
+    using SlotIndex  = uint32_t;
+    using Generation = uint32_t;
+    static constexpr SlotIndex InvalidSlot = UINT32_MAX;
+
+    struct HotSlot
+    {
+        Order::QuantityType quantity;
+        SlotIndex           next;   ///< Next order in the price level or next free slot
+    };
+    struct ColdSlot
+    {
+        Order::IdType    id;
+        Order::PriceType price;
+        SlotIndex        prev;        ///< Previous order in the price level
+        Generation       generation;  ///< Incremented on release, so stale handles to the slot are detected
+        Order::Type      type;
+    };
+    struct OwnerSlot
+    {
+        Order::OwnerType owner;
+        SlotIndex        prev;      ///< Previous order of the owner
+        SlotIndex        next;      ///< Next order of the owner
+    };
+    struct TimerSlot
+    {
+        Order::TimeType expiry;  ///< Order::NoExpiry in case the order is not in the timing wheel
+        SlotIndex       prev;    ///< Previous order of the timing wheel bucket
+        SlotIndex       next;    ///< Next order of the timing wheel bucket
+    };
+
+    /**
+     *  @param arena Memory of slots, nullptr means the default heap
+     */
+    explicit OrderPool(MemoryArena* arena = nullptr);
+
+    /**
+     *  @brief Store order in a free slot, the slot is not linked to any price level, owner list or timing wheel
+     */
+    SlotIndex allocate(const Order& order);
+
+    void release(SlotIndex slot);
+
+    /**
+     *  @brief Release all slots keeping allocated memory, handles to all slots become stale
+     */
+    void clear();
+
+    /**
+     *  @return Copy of the order kept in slot
+     */
+    [[nodiscard]] Order restore(SlotIndex slot) const;
+
+    /**
+     *  @return Copy of the order kept in slot with replaced quantity
+     */
+    [[nodiscard]] Order restore(SlotIndex           slot,
+                                Order::QuantityType quantity) const;
+
+    [[nodiscard]] HotSlot&        hot (SlotIndex slot)       { return _hot [slot]; }
+    [[nodiscard]] const HotSlot&  hot (SlotIndex slot) const { return _hot [slot]; }
+    [[nodiscard]] ColdSlot&       cold(SlotIndex slot)       { return _cold[slot]; }
+    [[nodiscard]] const ColdSlot& cold(SlotIndex slot) const { return _cold[slot]; }
+
+    [[nodiscard]] OwnerSlot&       owner(SlotIndex slot)       { return _owners[slot]; }
+    [[nodiscard]] const OwnerSlot& owner(SlotIndex slot) const { return _owners[slot]; }
+
+    [[nodiscard]] TimerSlot&       timer(SlotIndex slot)       { return _timers[slot]; }
+    [[nodiscard]] const TimerSlot& timer(SlotIndex slot) const { return _timers[slot]; }
+
+    /**
+     *  @return true if slot keeps order with given generation
+     */
+    [[nodiscard]] bool isValid(SlotIndex  slot,
+                               Generation generation) const
+    {
+        return slot < _cold.size() && _cold[slot].generation == generation && _hot[slot].quantity != 0;
+    }
+
+    /**
+     *  @return Number of orders in use
+     */
+    [[nodiscard]] size_t size() const { return _size; }
+
+private:
+    ArenaVector<HotSlot>   _hot;
+    ArenaVector<ColdSlot>  _cold;
+    ArenaVector<OwnerSlot> _owners;
+    ArenaVector<TimerSlot> _timers;
+    SlotIndex              _freeHead;
+    size_t                 _size;
+};
\ No newline at end of file
@@ -0,0 +1,43 @@
+#include "OwnerLists.h"
+
+OrderPool::SlotIndex OwnerLists::head(Order::OwnerType owner) const
+{
+    auto it = _heads.find(owner);
+    return it == _heads.end() ? OrderPool::InvalidSlot : it->second;
+}
+
+void OwnerLists::link(OrderPool&           pool,
+                      OrderPool::SlotIndex slot)
+{
+    auto& ownerSlot = pool.owner(slot);
+    if (ownerSlot.owner == Order::NoOwner)
+        return;
+
+    auto res = _heads.emplace(ownerSlot.owner, slot);
+    ownerSlot.prev = OrderPool::InvalidSlot;
+    ownerSlot.next = OrderPool::InvalidSlot;
+    if (not res.second)  // Push front to the existing list
+    {
+        auto& head = res.first->second;
+        ownerSlot.next = head;
+        pool.owner(head).prev = slot;
+        head = slot;
+    }
+}
+
+void OwnerLists::unlink(OrderPool&           pool,
+                        OrderPool::SlotIndex slot)
+{
+    const auto& ownerSlot = pool.owner(slot);
+    if (ownerSlot.owner == Order::NoOwner)
+        return;
+
+    if (ownerSlot.next != OrderPool::InvalidSlot)
+        pool.owner(ownerSlot.next).prev = ownerSlot.prev;
+    if (ownerSlot.prev != OrderPool::InvalidSlot)
+        pool.owner(ownerSlot.prev).next = ownerSlot.next;
+    else if (ownerSlot.next != OrderPool::InvalidSlot)
+        _heads[ownerSlot.owner] = ownerSlot.next;
+    else
+        _heads.erase(ownerSlot.owner);
+}
\ No newline at end of file
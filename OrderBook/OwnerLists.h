@@ -0,0 +1,37 @@
+#pragma once
+
+#include <unordered_map>
+
+#include "OrderPool.h"
+
+/**
+ *  @brief Intrusive lists of resting orders per owner
+ *
+ *  @details Orders of an owner are linked through OrderPool owner slots,
+ *           only owners with resting orders have list heads. Orders without owner are not linked.
+ */
+class OwnerLists
+{
+public:
+    /**
+     *  @return The first order of owner or OrderPool::InvalidSlot in case the owner has no orders
+     */
+    [[nodiscard]] OrderPool::SlotIndex head(Order::OwnerType owner) const;
+
+    /**
+     *  @brief Link order kept in slot to the list of its owner
+     */
+    void link(OrderPool&           pool,
+              OrderPool::SlotIndex slot);
+
+    /**
+     *  @brief Unlink order kept in slot from the list of its owner, the slot is not released
+     */
+    void unlink(OrderPool&           pool,
+                OrderPool::SlotIndex slot);
+
+    void clear() { _heads.clear(); }
+
+private:
+    std::unordered_map<Order::OwnerType, OrderPool::SlotIndex> _heads;
+};
\ No newline at end of file
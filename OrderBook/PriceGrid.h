@@ -0,0 +1,227 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include "InvalidPriceException.h"
+#include "OrderBook.h"
+
+/**
+ *  @brief Compile-time tick size and price band of an instrument
+ *
+ *  @details Prices are integers in the smallest price unit, e.g. fixed-point with implied decimals.
+ *           Valid prices are multiples of TickSize within [MinPrice, MaxPrice]. The configuration itself is
+ *           checked at compile time, and so are constant prices taken with price<Price>().
+ */
+template <Order::PriceType TickSize,
+          Order::PriceType MinPrice,
+          Order::PriceType MaxPrice>
+struct PriceGrid
+{
+    static_assert(TickSize > 0,                                      "Tick size must be positive");
+    static_assert(MinPrice <= MaxPrice,                              "Price band must not be empty");
+    static_assert(MinPrice % TickSize == 0 && MaxPrice % TickSize == 0, "Price band must be on the tick grid");
+
+    static constexpr Order::PriceType tickSize = TickSize;
+    static constexpr Order::PriceType minPrice = MinPrice;
+    static constexpr Order::PriceType maxPrice = MaxPrice;
+
+    /**
+     *  @brief Number of prices in the band, e.g. to size per-tick arrays
+     */
+    static constexpr size_t tickCount = static_cast<size_t>( (static_cast<int64_t>(MaxPrice) - MinPrice) / TickSize ) + 1;
+
+    [[nodiscard]] static constexpr bool isValid(Order::PriceType price)
+    {
+        return price >= MinPrice && price <= MaxPrice && price % TickSize == 0;
+    }
+
+    /**
+     *  @return Position of valid price in the band, 0 for MinPrice
+     */
+    [[nodiscard]] static constexpr size_t tickIndex(Order::PriceType price)
+    {
+        return static_cast<size_t>( (static_cast<int64_t>(price) - MinPrice) / TickSize );
+    }
+
+    /**
+     *  @brief Constant price checked at compile time
+     */
+    template <Order::PriceType Price>
+    [[nodiscard]] static constexpr Order::PriceType price()
+    {
+        static_assert(isValid(Price), "Price is off the tick grid or out of the price band");
+        return Price;
+    }
+};
+
+template <Order::PriceType TickSize,
+          Order::PriceType MinPrice,
+          Order::PriceType MaxPrice>
+constexpr Order::PriceType PriceGrid<TickSize, MinPrice, MaxPrice>::tickSize;
+
+template <Order::PriceType TickSize,
+          Order::PriceType MinPrice,
+          Order::PriceType MaxPrice>
+constexpr Order::PriceType PriceGrid<TickSize, MinPrice, MaxPrice>::minPrice;
+
+template <Order::PriceType TickSize,
+          Order::PriceType MinPrice,
+          Order::PriceType MaxPrice>
+constexpr Order::PriceType PriceGrid<TickSize, MinPrice, MaxPrice>::maxPrice;
+
+template <Order::PriceType TickSize,
+          Order::PriceType MinPrice,
+          Order::PriceType MaxPrice>
+constexpr size_t PriceGrid<TickSize, MinPrice, MaxPrice>::tickCount;
+
+/**
+ *  @brief Order book which accepts only prices of the Grid
+ *
+ *  @details Orders entering through this class are checked before they reach the book, the check is two
+ *           comparisons and a remainder by a compile-time constant. The book is mutated only through this
+ *           class, so every resting price is on the grid. Queries are reached through book().
+ */
+template <typename Grid>
+class GridOrderBook
+{
+public:
+    using GridType = Grid;
+
+    explicit GridOrderBook(OrderBook::OrderCallback      executedOrderCallback = nullptr,
+                           OrderBook::OrderCallback      canceledOrderCallback = nullptr,
+                           OrderBook::OrderBatchCallback canceledBatchCallback = nullptr)
+        : _book( std::move(executedOrderCallback), std::move(canceledOrderCallback), std::move(canceledBatchCallback) )
+    {}
+
+    [[nodiscard]] const OrderBook& book() const { return _book; }
+
+    /**
+     *  @throws InvalidPriceException Thrown in case the price is not on the grid
+     *
+     *  @see OrderBook::addOrder
+     */
+    Order::IdType addOrder(Order::Type         type,
+                           Order::PriceType    price,
+                           Order::QuantityType quantity,
+                           Order::OwnerType    owner  = Order::NoOwner,
+                           Order::TimeType     expiry = Order::NoExpiry)
+    {
+        checkPrice(price);
+        return _book.addOrder(type, price, quantity, owner, expiry);
+    }
+
+    /**
+     *  @throws InvalidPriceException Thrown in case the price is not on the grid
+     *
+     *  @see OrderBook::addOrderWithHandle
+     */
+    OrderBook::OrderHandle addOrderWithHandle(Order::Type         type,
+                                              Order::PriceType    price,
+                                              Order::QuantityType quantity,
+                                              Order::OwnerType    owner  = Order::NoOwner,
+                                              Order::TimeType     expiry = Order::NoExpiry)
+    {
+        checkPrice(price);
+        return _book.addOrderWithHandle(type, price, quantity, owner, expiry);
+    }
+
+    /**
+     *  @throws InvalidPriceException Thrown in case the stop price is not on the grid
+     *
+     *  @see OrderBook::addStopOrder
+     */
+    Order::IdType addStopOrder(Order::Type         type,
+                               Order::PriceType    stopPrice,
+                               Order::QuantityType quantity,
+                               Order::OwnerType    owner = Order::NoOwner)
+    {
+        checkPrice(stopPrice);
+        return _book.addStopOrder(type, stopPrice, quantity, owner);
+    }
+
+    /**
+     *  @throws InvalidPriceException Thrown in case the stop price or the price is not on the grid
+     *
+     *  @see OrderBook::addStopLimitOrder
+     */
+    Order::IdType addStopLimitOrder(Order::Type         type,
+                                    Order::PriceType    stopPrice,
+                                    Order::PriceType    price,
+                                    Order::QuantityType quantity,
+                                    Order::OwnerType    owner = Order::NoOwner)
+    {
+        checkPrice(stopPrice);
+        checkPrice(price);
+        return _book.addStopLimitOrder(type, stopPrice, price, quantity, owner);
+    }
+
+    /**
+     *  @throws InvalidPriceException Thrown in case the new price is not on the grid
+     *
+     *  @see OrderBook::amendOrder
+     */
+    void amendOrder(Order::IdType       id,
+                    Order::PriceType    newPrice,
+                    Order::QuantityType newQuantity)
+    {
+        checkPrice(newPrice);
+        _book.amendOrder(id, newPrice, newQuantity);
+    }
+
+    /**
+     *  @throws InvalidPriceException Thrown in case a quote price is not on the grid, the book is not changed
+     *
+     *  @see OrderBook::massQuote
+     */
+    OrderBook::MassQuoteResult massQuote(Order::OwnerType                    owner,
+                                         const std::vector<OrderBook::Quote>& quotes,
+                                         std::vector<Order::IdType>&          ids)
+    {
+        for (const auto& quote : quotes)
+            checkPrice(quote.price);
+        return _book.massQuote(owner, quotes, ids);
+    }
+
+    /// Operations without new prices are forwarded as they are
+
+    void cancelOrder(Order::IdType id) { _book.cancelOrder(id); }
+
+    void cancelOrder(const OrderBook::OrderHandle& handle) { _book.cancelOrder(handle); }
+
+    OrderBook::CancelStatus tryCancelOrder(Order::IdType id) { return _book.tryCancelOrder(id); }
+
+    OrderBook::CancelStatus tryCancelOrder(const OrderBook::OrderHandle& handle) { return _book.tryCancelOrder(handle); }
+
+    OrderBook::CancelStatus tryCancelStopOrder(Order::IdType id) { return _book.tryCancelStopOrder(id); }
+
+    size_t cancelAllForOwner(Order::OwnerType owner) { return _book.cancelAllForOwner(owner); }
+
+    size_t cancelAllOrders() { return _book.cancelAllOrders(); }
+
+    size_t cancelOrders(Order::Type type) { return _book.cancelOrders(type); }
+
+    size_t cancelOrders(Order::Type      type,
+                        Order::PriceType minPrice,
+                        Order::PriceType maxPrice)
+    {
+        return _book.cancelOrders(type, minPrice, maxPrice);
+    }
+
+    size_t advanceTime(Order::TimeType now) { return _book.advanceTime(now); }
+
+    void startAuction() { _book.startAuction(); }
+
+    OrderBook::AuctionResult uncross() { return _book.uncross(); }
+
+    void setL3Callback(OrderBook::L3EventCallback callback) { _book.setL3Callback( std::move(callback) ); }
+
+private:
+    OrderBook _book;
+
+    static void checkPrice(Order::PriceType price)
+    {
+        if ( not Grid::isValid(price) )
+            throw InvalidPriceException( std::string("Price ") + std::to_string(price) + " is not on the tick grid" );
+    }
+};
\ No newline at end of file
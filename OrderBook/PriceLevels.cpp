@@ -0,0 +1,123 @@
+#include "PriceLevels.h"
+
+#include <algorithm>
+
+PriceLevels::PriceLevels(Order::Type  type,
+                         MemoryArena* arena)
+    : _type      ( type )
+    , _prices    ( ArenaAllocator<Order::PriceType>        (arena) )
+    , _quantities( ArenaAllocator<Order::TotalQuantityType>(arena) )
+    , _queues    ( ArenaAllocator<Queue>                   (arena) )
+{}
+
+PriceLevels::LevelIndex PriceLevels::lowerBound(Order::PriceType price) const
+{
+    auto it = std::lower_bound(_prices.cbegin(), _prices.cend(), price,
+                               [this](Order::PriceType levelPrice, Order::PriceType price)
+                               {
+                                   return isBetter(price, levelPrice);
+                               });
+    return static_cast<LevelIndex>( it - _prices.cbegin() );
+}
+
+std::pair<PriceLevels::LevelIndex, PriceLevels::LevelIndex> PriceLevels::range(Order::PriceType p1,
+                                                                               Order::PriceType p2) const
+{
+    if ( isBetter(p2, p1) )
+        std::swap(p1, p2);
+
+    /// p2 is the worse bound, levels strictly better than p1 are out of range
+    auto last = std::upper_bound(_prices.cbegin(), _prices.cend(), p1,
+                                 [this](Order::PriceType price, Order::PriceType levelPrice)
+                                 {
+                                     return isBetter(levelPrice, price);
+                                 });
+    return std::make_pair( lowerBound(p2), static_cast<LevelIndex>( last - _prices.cbegin() ) );
+}
+
+std::pair<bool, PriceLevels::LevelIndex> PriceLevels::find(Order::PriceType price) const
+{
+    auto level = lowerBound(price);
+    return std::make_pair( level != _prices.size() && _prices[level] == price, level );
+}
+
+PriceLevels::LevelIndex PriceLevels::findOrInsert(Order::PriceType price)
+{
+    /// The best level is checked first as the most of orders come there
+    if ( not _prices.empty() && _prices.back() == price )
+        return best();
+
+    auto level = lowerBound(price);
+    if ( level == _prices.size() || _prices[level] != price )
+    {
+        _prices    .insert( _prices    .begin() + level, price );
+        _quantities.insert( _quantities.begin() + level, 0     );
+        _queues    .insert( _queues    .begin() + level, Queue{OrderPool::InvalidSlot, OrderPool::InvalidSlot} );
+    }
+    return level;
+}
+
+void PriceLevels::erase(LevelIndex level)
+{
+    assert(_queues[level].head == OrderPool::InvalidSlot);
+    _prices    .erase( _prices    .begin() + level );
+    _quantities.erase( _quantities.begin() + level );
+    _queues    .erase( _queues    .begin() + level );
+}
+
+void PriceLevels::erase(LevelIndex first,
+                        LevelIndex last)
+{
+    _prices    .erase( _prices    .begin() + first, _prices    .begin() + last );
+    _quantities.erase( _quantities.begin() + first, _quantities.begin() + last );
+    _queues    .erase( _queues    .begin() + first, _queues    .begin() + last );
+}
+
+void PriceLevels::pushBack(OrderPool&           pool,
+                           LevelIndex           level,
+                           OrderPool::SlotIndex slot)
+{
+    auto& queue = _queues[level];
+    assert(pool.cold(slot).price == _prices[level]);
+
+    pool.hot (slot).next = OrderPool::InvalidSlot;
+    pool.cold(slot).prev = queue.tail;
+    if (queue.tail != OrderPool::InvalidSlot)
+        pool.hot(queue.tail).next = slot;
+    else
+        queue.head = slot;
+    queue.tail = slot;
+
+    _quantities[level] += pool.hot(slot).quantity;
+}
+
+void PriceLevels::unlink(OrderPool&           pool,
+                         LevelIndex           level,
+                         OrderPool::SlotIndex slot)
+{
+    auto& queue = _queues[level];
+    auto next = pool.hot (slot).next;
+    auto prev = pool.cold(slot).prev;
+
+    if (prev != OrderPool::InvalidSlot)
+        pool.hot(prev).next = next;
+    else
+        queue.head = next;
+    if (next != OrderPool::InvalidSlot)
+        pool.cold(next).prev = prev;
+    else
+        queue.tail = prev;
+
+    _quantities[level] -= pool.hot(slot).quantity;
+}
+
+void PriceLevels::reduce(OrderPool&           pool,
+                         LevelIndex           level,
+                         OrderPool::SlotIndex slot,
+                         Order::QuantityType  quantity)
+{
+    auto& hot = pool.hot(slot);
+    assert(quantity <= hot.quantity);
+    hot.quantity       -= quantity;
+    _quantities[level] -= quantity;
+}
\ No newline at end of file
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "OrderPool.h"
+
+/**
+ *  @brief Non-empty price levels of one order book side
+ *
+ *  @details Levels are kept in parallel arrays sorted from the worst price to the best one,
+ *           so the best level is the last one and changes near the top of the book are cheap.
+ *           Orders of a level form an intrusive FIFO list over OrderPool slots.
+ */
+class PriceLevels
+{
+public:
+    using LevelIndex = size_t;
+
+    struct Queue
+    {
+        OrderPool::SlotIndex head;
+        OrderPool::SlotIndex tail;
+    };
+
+    /**
+     *  @param arena Memory of level arrays, nullptr means the default heap
+     */
+    explicit PriceLevels(Order::Type  type,
+                         MemoryArena* arena = nullptr);
+
+    [[nodiscard]] Order::Type getType() const { return _type; }
+
+    [[nodiscard]] bool   empty() const { return _prices.empty(); }
+    [[nodiscard]] size_t size () const { return _prices.size();  }
+
+    /**
+     *  @note Levels must not be empty
+     */
+    [[nodiscard]] LevelIndex best() const { return _prices.size() - 1; }
+
+    [[nodiscard]] Order::PriceType         price   (LevelIndex level) const { return _prices    [level]; }
+    [[nodiscard]] Order::TotalQuantityType quantity(LevelIndex level) const { return _quantities[level]; }
+    [[nodiscard]] const Queue&             queue   (LevelIndex level) const { return _queues    [level]; }
+
+    /**
+     *  @return Contiguous array of level total quantities, the best level is the last one
+     */
+    [[nodiscard]] const Order::TotalQuantityType* quantities() const { return _quantities.data(); }
+
+    /**
+     *  @return true if price p1 is better than price p2 for this side
+     */
+    [[nodiscard]] bool isBetter(Order::PriceType p1,
+                                Order::PriceType p2) const
+    {
+        return _type == Order::Type::Bid ? p1 > p2 : p1 < p2;
+    }
+
+    /**
+     *  @return true if incoming order of the opposite side with given price executes against the best level
+     *
+     *  @note Levels must not be empty
+     */
+    [[nodiscard]] bool crosses(Order::PriceType price) const
+    {
+        return not isBetter( price, _prices.back() );
+    }
+
+    /**
+     *  @return Number of the best levels which execute incoming order of the opposite side with given price
+     */
+    [[nodiscard]] size_t crossingCount(Order::PriceType price) const
+    {
+        return _prices.size() - lowerBound(price);
+    }
+
+    /**
+     *  @return Range [first, last) of levels with price between p1 and p2 inclusive
+     */
+    [[nodiscard]] std::pair<LevelIndex, LevelIndex> range(Order::PriceType p1,
+                                                          Order::PriceType p2) const;
+
+    /**
+     *  @return Pair of found flag and level index
+     */
+    [[nodiscard]] std::pair<bool, LevelIndex> find(Order::PriceType price) const;
+
+    /**
+     *  @brief Find level or insert the new empty one
+     *
+     *  @note Insertion invalidates indices of worse levels
+     */
+    LevelIndex findOrInsert(Order::PriceType price);
+
+    /**
+     *  @note Erasure invalidates indices of worse levels
+     */
+    void erase(LevelIndex level);
+
+    /**
+     *  @brief Erase levels [first, last) together with their queues, order slots are not released
+     */
+    void erase(LevelIndex first,
+               LevelIndex last);
+
+    /**
+     *  @brief Append order kept in slot to the back of the level queue
+     */
+    void pushBack(OrderPool&           pool,
+                  LevelIndex           level,
+                  OrderPool::SlotIndex slot);
+
+    /**
+     *  @brief Remove order kept in slot from the level queue, the slot is not released
+     */
+    void unlink(OrderPool&           pool,
+                LevelIndex           level,
+                OrderPool::SlotIndex slot);
+
+    /**
+     *  @brief Reduce quantity of order kept in slot without changing its position in the queue
+     */
+    void reduce(OrderPool&           pool,
+                LevelIndex           level,
+                OrderPool::SlotIndex slot,
+                Order::QuantityType  quantity);
+
+private:
+    Order::Type                           _type;
+    ArenaVector<Order::PriceType>         _prices;
+    ArenaVector<Order::TotalQuantityType> _quantities;
+    ArenaVector<Queue>                    _queues;
+
+    /**
+     *  @return Position of the first level which is not worse than price
+     */
+    [[nodiscard]] LevelIndex lowerBound(Order::PriceType price) const;
+};
\ No newline at end of file
@@ -0,0 +1,122 @@
+#include "Replayer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+static constexpr size_t MinPruneSize = 1024;
+
+/**
+ *  @brief FNV-1a step over value bytes
+ */
+template <typename T>
+static void hashValue(uint64_t& hash,
+                      T          value)
+{
+    for (size_t i = 0; i < sizeof(T); ++i)
+    {
+        hash ^= static_cast<uint8_t>( static_cast<uint64_t>(value) >> (8 * i) );
+        hash *= 0x100000001b3;
+    }
+}
+
+uint64_t depthChecksum(const OrderBook& book)
+{
+    uint64_t hash = 0xcbf29ce484222325;
+    std::vector<OrderBook::PricePosition> levels;
+    for (auto type : {Order::Type::Ask, Order::Type::Bid})
+    {
+        book.getPriceLevels(type, -1, levels);
+        hashValue( hash, levels.size() );
+        for (const auto& level : levels)
+        {
+            hashValue(hash, level.price);
+            hashValue(hash, level.quantity);
+        }
+    }
+    auto lastTransaction = book.getLastTransaction();
+    if (lastTransaction.first)
+    {
+        hashValue(hash, lastTransaction.second.price);
+        hashValue(hash, lastTransaction.second.quantity);
+    }
+    return hash;
+}
+
+Replayer::Replayer(OrderBook& book)
+    : _book     ( book )
+    , _pruneSize( MinPruneSize )
+{}
+
+bool Replayer::apply(const ReplayEvent& event)
+{
+    if ( not isValid(event) )
+        return false;
+    if (event.kind == ReplayEvent::Kind::Add)
+    {
+        if (event.quantity == 0)
+            return false;
+        auto handle = _book.addOrderWithHandle( event.type, static_cast<Order::PriceType>(event.price), event.quantity );
+        if (handle.slot != OrderPool::InvalidSlot)  // Fully executed orders are not mapped
+        {
+            _ids[event.id] = handle;
+            if (_ids.size() >= _pruneSize)
+                prune();
+        }
+        return true;
+    }
+
+    auto it = _ids.find(event.id);
+    if ( it == _ids.end() )
+        return false;
+    auto handle = it->second;
+    if (event.kind == ReplayEvent::Kind::Cancel || event.quantity == 0)
+    {
+        _ids.erase(it);
+        return _book.tryCancelOrder(handle) == OrderBook::CancelStatus::Canceled;
+    }
+    if ( not _book.findOrderById(handle).first )  // Executed by a later order
+    {
+        _ids.erase(it);
+        return false;
+    }
+    _book.amendOrder( handle.id, static_cast<Order::PriceType>(event.price), event.quantity );
+    return true;
+}
+
+void Replayer::prune()
+{
+    for (auto it = _ids.begin(); it != _ids.end();)
+    {
+        if ( _book.findOrderById(it->second).first )
+            ++it;
+        else
+            it = _ids.erase(it);
+    }
+    _pruneSize = std::max(_ids.size() * 2, MinPruneSize);
+}
+
+Replayer::Stats Replayer::replay(const ReplayEvent* begin,
+                                 const ReplayEvent* end,
+                                 double             speed)
+{
+    Stats stats;
+    auto start = std::chrono::steady_clock::now();
+    auto firstTimestamp = begin != end ? begin->timestamp : 0;
+    for (auto event = begin; event != end; ++event)
+    {
+        if (speed > 0)
+        {
+            /// Events stamped before the first one (clock step, merged feeds) are due at once
+            auto elapsed = event->timestamp > firstTimestamp ? event->timestamp - firstTimestamp : 0;
+            auto offset = std::chrono::nanoseconds( static_cast<int64_t>(elapsed / speed) );
+            std::this_thread::sleep_until(start + offset);
+        }
+        if ( not apply(*event) )
+            ++stats.skipped;
+        ++stats.events;
+    }
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return stats;
+}
\ No newline at end of file
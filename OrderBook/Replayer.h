@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+
+#include "EventFile.h"
+#include "OrderBook.h"
+
+/**
+ *  @brief Checksum of the aggregated depth of both sides and the last transaction
+ *
+ *  @details Equal books have equal checksums regardless of order IDs, so runs of the same flow can be compared
+ */
+uint64_t depthChecksum(const OrderBook& book);
+
+/**
+ *  @brief Feeds recorded order flow to order book
+ */
+class Replayer
+{
+public:
+    struct Stats
+    {
+        uint64_t events  = 0;
+        uint64_t skipped = 0;  ///< Cancel or amend of orders not in the book, add of zero quantity, invalid event
+        double   seconds = 0;
+
+        [[nodiscard]] double eventsPerSecond() const { return seconds > 0 ? events / seconds : 0; }
+    };
+
+    explicit Replayer(OrderBook& book);
+
+    /**
+     *  @param speed 0 replays at full speed, 1 at recorded pace, 2 twice faster and so on
+     *
+     *  @details Original IDs are mapped to book IDs, the mapping is kept between calls
+     */
+    Stats replay(const ReplayEvent* begin,
+                 const ReplayEvent* end,
+                 double             speed = 0);
+
+    /**
+     *  @return Number of mapped original IDs, at most twice the resting orders or a small constant
+     */
+    [[nodiscard]] size_t getMappedCount() const { return _ids.size(); }
+
+private:
+    OrderBook&                                           _book;
+    std::unordered_map<uint64_t, OrderBook::OrderHandle> _ids;        ///< Original ID to handle of orders which may rest
+    size_t                                               _pruneSize;  ///< Size of _ids which triggers prune()
+
+    bool apply(const ReplayEvent& event);
+
+    /**
+     *  @brief Remove mapping of orders executed by later orders
+     *
+     *  @details Executed orders are not reported to the replayer, so they are found by their stale handles.
+     *           The next prune is due when the mapping doubles, so the cost per added order is constant
+     */
+    void prune();
+};
\ No newline at end of file
@@ -0,0 +1,147 @@
+#include "SharedMemory.h"
+
+#include <cerrno>
+#include <system_error>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static std::system_error systemError(const std::string& call,
+                                     const std::string& name,
+                                     int                error = errno)
+{
+    return std::system_error(error, std::generic_category(), call + ' ' + name);
+}
+
+/**
+ *  @brief Map descriptor and close it, the mapping stays valid
+ */
+static void* mapDescriptor(int                fd,
+                           size_t             size,
+                           bool               writable,
+                           const std::string& name)
+{
+    auto protection = writable ? PROT_READ | PROT_WRITE : PROT_READ;
+    void* data = mmap(nullptr, size, protection, MAP_SHARED, fd, 0);
+    int error = errno;
+    close(fd);
+    if (data == MAP_FAILED)
+        throw systemError("mmap", name, error);
+    return data;
+}
+
+SharedMemory SharedMemory::create(const std::string& name,
+                                  size_t             size)
+{
+    shm_unlink( name.c_str() );  // Stale object of a crashed process
+    int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0)
+        throw systemError("shm_open", name);
+    if (ftruncate(fd, static_cast<off_t>(size)) != 0)
+    {
+        int error = errno;
+        close(fd);
+        shm_unlink( name.c_str() );
+        throw systemError("ftruncate", name, error);
+    }
+    try
+    {
+        return SharedMemory( name, mapDescriptor(fd, size, true, name), size, true );
+    }
+    catch (...)
+    {
+        shm_unlink( name.c_str() );
+        throw;
+    }
+}
+
+SharedMemory SharedMemory::open(const std::string& name,
+                                bool               writable)
+{
+    int fd = shm_open(name.c_str(), writable ? O_RDWR : O_RDONLY, 0);
+    if (fd < 0)
+        throw systemError("shm_open", name);
+    struct stat status{};
+    if (fstat(fd, &status) != 0)
+    {
+        int error = errno;
+        close(fd);
+        throw systemError("fstat", name, error);
+    }
+    auto size = static_cast<size_t>(status.st_size);
+    return SharedMemory( name, mapDescriptor(fd, size, writable, name), size, false );
+}
+
+SharedMemory SharedMemory::mapFile(const std::string& path)
+{
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw systemError("open", path);
+    struct stat status{};
+    if (fstat(fd, &status) != 0)
+    {
+        int error = errno;
+        close(fd);
+        throw systemError("fstat", path, error);
+    }
+    auto size = static_cast<size_t>(status.st_size);
+    if (size == 0)
+    {
+        close(fd);
+        return SharedMemory(path, nullptr, 0, false);
+    }
+    return SharedMemory( path, mapDescriptor(fd, size, false, path), size, false );
+}
+
+SharedMemory::SharedMemory(std::string name,
+                           void*       data,
+                           size_t      size,
+                           bool        isOwner)
+    : _name   ( std::move(name) )
+    , _data   ( data )
+    , _size   ( size )
+    , _isOwner( isOwner )
+{}
+
+SharedMemory::SharedMemory(SharedMemory&& other) noexcept
+    : _name   ( std::move(other._name) )
+    , _data   ( other._data )
+    , _size   ( other._size )
+    , _isOwner( other._isOwner )
+{
+    other._data    = nullptr;
+    other._isOwner = false;
+}
+
+SharedMemory& SharedMemory::operator =(SharedMemory&& other) noexcept
+{
+    if (this != &other)
+    {
+        reset();
+        _name    = std::move(other._name);
+        _data    = other._data;
+        _size    = other._size;
+        _isOwner = other._isOwner;
+        other._data    = nullptr;
+        other._isOwner = false;
+    }
+    return *this;
+}
+
+SharedMemory::~SharedMemory()
+{
+    reset();
+}
+
+void SharedMemory::reset()
+{
+    if (_data)
+        munmap(_data, _size);
+    if (_isOwner)
+        shm_unlink( _name.c_str() );
+    _data    = nullptr;
+    _isOwner = false;
+}
\ No newline at end of file
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+/**
+ *  @brief POSIX shared memory object or file mapped to the address space of the process
+ *
+ *  @details The creator owns the object name and unlinks it on destruction,
+ *           processes which opened the object keep their mappings until they are destroyed.
+ *           Failures of system calls are reported by std::system_error.
+ */
+class SharedMemory
+{
+public:
+    /**
+     *  @brief Create zero filled object of given size, the existing object with the same name is replaced
+     *
+     *  @param name Object name starting with '/'
+     */
+    static SharedMemory create(const std::string& name,
+                               size_t             size);
+
+    /**
+     *  @brief Map the existing object with its full size
+     */
+    static SharedMemory open(const std::string& name,
+                             bool               writable = false);
+
+    /**
+     *  @brief Map the whole regular file read only, the empty file has no data
+     */
+    static SharedMemory mapFile(const std::string& path);
+
+    SharedMemory(SharedMemory&& other) noexcept;
+    SharedMemory& operator =(SharedMemory&& other) noexcept;
+    SharedMemory(const SharedMemory&) = delete;
+    SharedMemory& operator =(const SharedMemory&) = delete;
+    ~SharedMemory();
+
+    [[nodiscard]] void*  data() const { return _data; }
+    [[nodiscard]] size_t size() const { return _size; }
+
+private:
+    std::string _name;
+    void*       _data;
+    size_t      _size;
+    bool        _isOwner;  ///< Unlink the shared memory object name on destruction
+
+    SharedMemory(std::string name,
+                 void*       data,
+                 size_t      size,
+                 bool        isOwner);
+
+    void reset();
+};
\ No newline at end of file
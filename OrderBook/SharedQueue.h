@@ -0,0 +1,82 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+/**
+ *  @brief Single producer single consumer queue placed in memory shared by two processes
+ *
+ *  @details Producer and consumer use their own SharedQueue objects over the same memory, each caches
+ *           the index of the other side to touch its cache line only when the queue looks full or empty.
+ *           Capacity must be a power of two, zero filled memory is the empty queue.
+ */
+template <typename T>
+class SharedQueue
+{
+    static_assert(std::is_trivially_copyable<T>::value, "Queue items are copied as raw memory");
+
+public:
+    static size_t memorySize(uint32_t capacity) { return sizeof(Header) + capacity * sizeof(T); }
+
+    SharedQueue(void*    memory,
+                uint32_t capacity)
+        : _header    ( static_cast<Header*>(memory) )
+        , _items     ( reinterpret_cast<T*>(_header + 1) )
+        , _mask      ( capacity - 1 )
+        , _cachedHead( _header->head.load(std::memory_order_acquire) )
+        , _cachedTail( _header->tail.load(std::memory_order_acquire) )
+    {}
+
+    /**
+     *  @return false in case the queue is full
+     *
+     *  @note Producer only
+     */
+    bool tryPush(const T& item)
+    {
+        auto tail = _header->tail.load(std::memory_order_relaxed);
+        if (tail - _cachedHead > _mask)
+        {
+            _cachedHead = _header->head.load(std::memory_order_acquire);
+            if (tail - _cachedHead > _mask)
+                return false;
+        }
+        _items[tail & _mask] = item;
+        _header->tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     *  @return false in case the queue is empty
+     *
+     *  @note Consumer only
+     */
+    bool tryPop(T& item)
+    {
+        auto head = _header->head.load(std::memory_order_relaxed);
+        if (head == _cachedTail)
+        {
+            _cachedTail = _header->tail.load(std::memory_order_acquire);
+            if (head == _cachedTail)
+                return false;
+        }
+        item = _items[head & _mask];
+        _header->head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    struct Header
+    {
+        alignas(64) std::atomic<uint64_t> head;  ///< Written by consumer
+        alignas(64) std::atomic<uint64_t> tail;  ///< Written by producer
+    };
+
+    Header*  _header;
+    T*       _items;
+    uint64_t _mask;
+    uint64_t _cachedHead;  ///< Producer view of head
+    uint64_t _cachedTail;  ///< Consumer view of tail
+};
\ No newline at end of file
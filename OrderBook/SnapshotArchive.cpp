@@ -0,0 +1,309 @@
+#include "SnapshotArchive.h"
+
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+
+static constexpr uint64_t ArchiveMagic   = 0x4f424c3241524331;  // "OBL2ARC1"
+static constexpr uint32_t ArchiveVersion = 1;
+
+struct ArchiveHeader
+{
+    uint64_t magic;         ///< Written by close(), so the file is rejected until it is complete
+    uint32_t version;
+    uint32_t reserved;
+    uint64_t recordsEnd;
+    uint64_t indexOffset;   ///< Aligned to 8 bytes
+    uint64_t keyframeCount;
+};
+
+static_assert(sizeof(ArchiveHeader) % alignof(SnapshotArchiveKeyframe) == 0, "Records follow the header");
+
+/// Record starts with varint (timestamp << 1 | isKeyframe), keyframe timestamp is absolute, others are
+/// differences from the previous record. Keyframe keeps bid and ask counts followed by levels of the side,
+/// other record keeps the count of changes followed by changes. Level is varint (zigzag price difference << 1 | side)
+/// and varint quantity, 0 quantity removes the level
+
+static uint64_t zigzag(int64_t value)
+{
+    return ( static_cast<uint64_t>(value) << 1 ) ^ static_cast<uint64_t>(value >> 63);
+}
+
+static int64_t unzigzag(uint64_t value)
+{
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+static uint8_t sideBit(Order::Type side)
+{
+    return side == Order::Type::Bid ? 0 : 1;
+}
+
+SnapshotArchiveWriter::SnapshotArchiveWriter(const std::string& path,
+                                             uint32_t           keyframeInterval,
+                                             int                depth)
+    : _file            ( path, std::ios::binary | std::ios::trunc )
+    , _keyframeInterval( std::max<uint32_t>(keyframeInterval, 1) )
+    , _depth           ( depth )
+    , _sinceKeyframe   ( 0 )
+    , _recordCount     ( 0 )
+    , _size            ( sizeof(ArchiveHeader) )
+    , _lastTimestamp   ( 0 )
+    , _lastPrice       ( 0 )
+{
+    if (not _file)
+        throw std::runtime_error("Cannot create snapshot archive " + path);
+    ArchiveHeader header{};
+    _file.write( reinterpret_cast<const char*>(&header), sizeof(header) );
+}
+
+SnapshotArchiveWriter::~SnapshotArchiveWriter()
+{
+    close();
+}
+
+void SnapshotArchiveWriter::encodeVarint(uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        _record.push_back( static_cast<uint8_t>(value | 0x80) );
+        value >>= 7;
+    }
+    _record.push_back( static_cast<uint8_t>(value) );
+}
+
+void SnapshotArchiveWriter::encodePrice(Order::PriceType price,
+                                        uint8_t          side)
+{
+    encodeVarint( zigzag( static_cast<int64_t>(price) - _lastPrice ) << 1 | side );
+    _lastPrice = price;
+}
+
+void SnapshotArchiveWriter::collectChanges(Order::Type                            side,
+                                           std::vector<OrderBook::PricePosition>& recorded)
+{
+    auto isBetter = [side](Order::PriceType p1, Order::PriceType p2)
+    {
+        return side == Order::Type::Bid ? p1 > p2 : p1 < p2;
+    };
+
+    /// Both sequences are sorted from the best price
+    size_t i = 0;
+    size_t j = 0;
+    while ( i < recorded.size() || j < _levels.size() )
+    {
+        if ( j == _levels.size() ||
+             ( i < recorded.size() && isBetter(recorded[i].price, _levels[j].price) ) )
+        {
+            _changes.push_back( Change{side, OrderBook::PricePosition{recorded[i].price, 0}} );
+            ++i;
+        }
+        else if ( i == recorded.size() || isBetter(_levels[j].price, recorded[i].price) )
+        {
+            _changes.push_back( Change{side, _levels[j]} );
+            ++j;
+        }
+        else
+        {
+            if (recorded[i].quantity != _levels[j].quantity)
+                _changes.push_back( Change{side, _levels[j]} );
+            ++i;
+            ++j;
+        }
+    }
+    recorded.swap(_levels);
+}
+
+bool SnapshotArchiveWriter::record(uint64_t         timestamp,
+                                   const OrderBook& book)
+{
+    assert(_recordCount == 0 || timestamp >= _lastTimestamp);
+    _changes.clear();
+    book.getPriceLevels(Order::Type::Bid, _depth, _levels);
+    collectChanges(Order::Type::Bid, _bids);
+    book.getPriceLevels(Order::Type::Ask, _depth, _levels);
+    collectChanges(Order::Type::Ask, _asks);
+    if ( _changes.empty() )
+        return false;
+
+    _record.clear();
+    if (_recordCount == 0 || _sinceKeyframe == _keyframeInterval)
+    {
+        _keyframes.push_back( SnapshotArchiveKeyframe{timestamp, _size} );
+        _sinceKeyframe = 0;
+        _lastPrice     = 0;
+        encodeVarint(timestamp << 1 | 1);
+        for (auto side : {Order::Type::Bid, Order::Type::Ask})
+        {
+            const auto& levels = side == Order::Type::Bid ? _bids : _asks;
+            encodeVarint( levels.size() );
+            for (const auto& level : levels)
+            {
+                encodePrice( level.price, sideBit(side) );
+                encodeVarint(level.quantity);
+            }
+        }
+    }
+    else
+    {
+        encodeVarint( (timestamp - _lastTimestamp) << 1 );
+        encodeVarint( _changes.size() );
+        for (const auto& change : _changes)
+        {
+            encodePrice( change.level.price, sideBit(change.side) );
+            encodeVarint(change.level.quantity);
+        }
+    }
+
+    _file.write( reinterpret_cast<const char*>( _record.data() ), static_cast<std::streamsize>( _record.size() ) );
+    _size         += _record.size();
+    _lastTimestamp = timestamp;
+    ++_sinceKeyframe;
+    ++_recordCount;
+    return true;
+}
+
+void SnapshotArchiveWriter::close()
+{
+    if ( not _file.is_open() )
+        return;
+
+    ArchiveHeader header{ArchiveMagic, ArchiveVersion, 0, _size, 0, _keyframes.size()};
+    static const char padding[alignof(SnapshotArchiveKeyframe)] = {};
+    auto paddingSize = (alignof(SnapshotArchiveKeyframe) - _size % alignof(SnapshotArchiveKeyframe)) % alignof(SnapshotArchiveKeyframe);
+    _file.write( padding, static_cast<std::streamsize>(paddingSize) );
+    header.indexOffset = _size + paddingSize;
+    _file.write( reinterpret_cast<const char*>( _keyframes.data() ),
+                 static_cast<std::streamsize>( _keyframes.size() * sizeof(SnapshotArchiveKeyframe) ) );
+    _size = header.indexOffset + _keyframes.size() * sizeof(SnapshotArchiveKeyframe);
+    _file.seekp(0);
+    _file.write( reinterpret_cast<const char*>(&header), sizeof(header) );
+    _file.close();
+}
+
+SnapshotArchive::SnapshotArchive(const std::string& path)
+    : _memory       ( SharedMemory::mapFile(path) )
+    , _data         ( static_cast<const uint8_t*>( _memory.data() ) )
+    , _recordsEnd   ( 0 )
+    , _keyframes    ( nullptr )
+    , _keyframeCount( 0 )
+{
+    const auto* header = static_cast<const ArchiveHeader*>( _memory.data() );
+    if ( _memory.size() < sizeof(ArchiveHeader) || header->magic != ArchiveMagic ||
+         header->version != ArchiveVersion || header->recordsEnd > header->indexOffset ||
+         header->indexOffset % alignof(SnapshotArchiveKeyframe) != 0 || header->indexOffset > _memory.size() ||
+         (_memory.size() - header->indexOffset) / sizeof(SnapshotArchiveKeyframe) < header->keyframeCount )
+        throw std::runtime_error("Not a snapshot archive " + path);
+
+    _recordsEnd    = header->recordsEnd;
+    _keyframes     = reinterpret_cast<const SnapshotArchiveKeyframe*>(_data + header->indexOffset);
+    _keyframeCount = header->keyframeCount;
+}
+
+uint64_t SnapshotArchive::getFirstTimestamp() const
+{
+    return _keyframeCount == 0 ? 0 : _keyframes[0].timestamp;
+}
+
+static uint64_t decodeVarint(const uint8_t* data,
+                             uint64_t&      offset,
+                             uint64_t       end)
+{
+    uint64_t value = 0;
+    for (unsigned shift = 0; shift < 64; shift += 7)
+    {
+        if (offset == end)
+            break;
+        auto byte = data[offset++];
+        value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if ( (byte & 0x80) == 0 )
+            return value;
+    }
+    throw std::runtime_error("Corrupt snapshot archive record");
+}
+
+/**
+ *  @brief Decode level and advance price difference base
+ */
+static Order::Type decodeLevel(const uint8_t*            data,
+                               uint64_t&                 offset,
+                               uint64_t                  end,
+                               Order::PriceType&         lastPrice,
+                               OrderBook::PricePosition& level)
+{
+    auto price = decodeVarint(data, offset, end);
+    lastPrice      = static_cast<Order::PriceType>( lastPrice + unzigzag(price >> 1) );
+    level.price    = lastPrice;
+    level.quantity = decodeVarint(data, offset, end);
+    return (price & 1) == 0 ? Order::Type::Bid : Order::Type::Ask;
+}
+
+/**
+ *  @brief Set, add or remove level of side sorted from the best price
+ */
+static void applyChange(Order::Type                            side,
+                        const OrderBook::PricePosition&        change,
+                        std::vector<OrderBook::PricePosition>& levels)
+{
+    auto position = std::lower_bound(levels.begin(), levels.end(), change.price,
+                                     [side](const OrderBook::PricePosition& level, Order::PriceType price)
+                                     {
+                                         return side == Order::Type::Bid ? level.price > price : level.price < price;
+                                     });
+    bool isFound = position != levels.end() && position->price == change.price;
+    if (change.quantity == 0)
+    {
+        if (isFound)
+            levels.erase(position);
+    }
+    else if (isFound)
+        position->quantity = change.quantity;
+    else
+        levels.insert(position, change);
+}
+
+bool SnapshotArchive::readAt(uint64_t      timestamp,
+                             ArchivedBook& book) const
+{
+    if (_keyframeCount == 0 || timestamp < _keyframes[0].timestamp)
+        return false;
+
+    auto keyframe = std::upper_bound(_keyframes, _keyframes + _keyframeCount, timestamp,
+                                     [](uint64_t time, const SnapshotArchiveKeyframe& entry) { return time < entry.timestamp; }) - 1;
+    uint64_t offset = keyframe->offset;
+    Order::PriceType lastPrice = 0;
+    OrderBook::PricePosition level;
+
+    if ( offset >= _recordsEnd || decodeVarint(_data, offset, _recordsEnd) != (keyframe->timestamp << 1 | 1) )
+        throw std::runtime_error("Corrupt snapshot archive record");
+    book.timestamp = keyframe->timestamp;
+    for (auto levels : {&book.bids, &book.asks})
+    {
+        auto count = decodeVarint(_data, offset, _recordsEnd);
+        if (count > _recordsEnd - offset)  // Every level takes 2 bytes at least
+            throw std::runtime_error("Corrupt snapshot archive record");
+        levels->resize(count);
+        for (auto& position : *levels)
+        {
+            decodeLevel(_data, offset, _recordsEnd, lastPrice, level);
+            position = level;
+        }
+    }
+
+    /// Changes are applied up to the next keyframe or the first record later than timestamp
+    while (offset < _recordsEnd)
+    {
+        auto head = decodeVarint(_data, offset, _recordsEnd);
+        if ( (head & 1) != 0 || book.timestamp + (head >> 1) > timestamp )
+            break;
+
+        book.timestamp += head >> 1;
+        auto count = decodeVarint(_data, offset, _recordsEnd);
+        for (uint64_t i = 0; i < count; ++i)
+        {
+            auto side = decodeLevel(_data, offset, _recordsEnd, lastPrice, level);
+            applyChange( side, level, side == Order::Type::Bid ? book.bids : book.asks );
+        }
+    }
+    return true;
+}
\ No newline at end of file
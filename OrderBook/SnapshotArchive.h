@@ -0,0 +1,142 @@
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "OrderBook.h"
+#include "SharedMemory.h"
+
+/**
+ *  @brief L2 of both sides at a point of archived history
+ */
+struct ArchivedBook
+{
+    uint64_t                              timestamp = 0;  ///< Timestamp of the last record reflected
+    std::vector<OrderBook::PricePosition> bids;           ///< The best level is the first one
+    std::vector<OrderBook::PricePosition> asks;
+};
+
+/**
+ *  @brief Entry of the keyframe index at the end of archive file
+ */
+struct SnapshotArchiveKeyframe
+{
+    uint64_t timestamp;
+    uint64_t offset;  ///< From the file start
+};
+
+/**
+ *  @brief Writer of compact L2 history: keyframes with all levels and level changes between them
+ *
+ *  @details record() compares the book with the previously recorded state and writes only changed levels,
+ *           prices as zigzag varint differences from the previous price and quantities as varints.
+ *           Every keyframeInterval records a keyframe with all levels is written, so reading any point
+ *           decodes at most keyframeInterval records. The keyframe index is written by close() or destructor
+ */
+class SnapshotArchiveWriter
+{
+public:
+    /**
+     *  @param depth Number of price levels per side recorded, -1 means all of them
+     *
+     *  @throws std::runtime_error Thrown in case the file cannot be created
+     */
+    explicit SnapshotArchiveWriter(const std::string& path,
+                                   uint32_t           keyframeInterval = 256,
+                                   int                depth            = -1);
+    ~SnapshotArchiveWriter();
+
+    SnapshotArchiveWriter(const SnapshotArchiveWriter&)            = delete;
+    SnapshotArchiveWriter& operator=(const SnapshotArchiveWriter&) = delete;
+
+    /**
+     *  @brief Record L2 of the book after a mutation or a batch of them
+     *
+     *  @return false in case L2 did not change and nothing is written
+     *
+     *  @details Timestamps must not decrease, time units are chosen by caller
+     */
+    bool record(uint64_t         timestamp,
+                const OrderBook& book);
+
+    void close();
+
+    [[nodiscard]] uint64_t getRecordCount() const { return _recordCount; }
+
+    /**
+     *  @return Bytes written so far, the whole file size after close()
+     */
+    [[nodiscard]] uint64_t getSize() const { return _size; }
+
+private:
+    /**
+     *  @brief New quantity of one level, 0 means the level is removed
+     */
+    struct Change
+    {
+        Order::Type              side;
+        OrderBook::PricePosition level;
+    };
+
+    std::ofstream                        _file;
+    uint32_t                             _keyframeInterval;
+    int                                  _depth;
+    uint32_t                             _sinceKeyframe;  ///< Records since the last keyframe
+    uint64_t                             _recordCount;
+    uint64_t                             _size;
+    uint64_t                             _lastTimestamp;
+    Order::PriceType                     _lastPrice;      ///< Base of the next price difference, 0 at every keyframe
+    std::vector<SnapshotArchiveKeyframe> _keyframes;
+    std::vector<Change>                  _changes;        ///< Changes of the current record, capacity is reused
+    std::vector<uint8_t>                 _record;         ///< Encoded record, capacity is reused
+
+    std::vector<OrderBook::PricePosition> _bids;    ///< Recorded state
+    std::vector<OrderBook::PricePosition> _asks;
+    std::vector<OrderBook::PricePosition> _levels;  ///< Current state of a side, capacity is reused
+
+    /**
+     *  @brief Collect changes of one side and make current levels the recorded ones
+     */
+    void collectChanges(Order::Type                            side,
+                        std::vector<OrderBook::PricePosition>& recorded);
+
+    void encodeVarint(uint64_t value);
+
+    void encodePrice(Order::PriceType price,
+                     uint8_t          side);
+};
+
+/**
+ *  @brief Memory mapped archive written by SnapshotArchiveWriter
+ *
+ *  @throws std::runtime_error Thrown in case the file is not a closed snapshot archive
+ */
+class SnapshotArchive
+{
+public:
+    explicit SnapshotArchive(const std::string& path);
+
+    /**
+     *  @brief Reconstruct L2 as of timestamp: the state after the last record not later than it
+     *
+     *  @return false in case the archive has no records up to timestamp
+     *
+     *  @details Finds the keyframe by binary search and decodes records after it, capacity of book is reused
+     *
+     *  @throws std::runtime_error Thrown in case a record is corrupt
+     */
+    bool readAt(uint64_t      timestamp,
+                ArchivedBook& book) const;
+
+    [[nodiscard]] bool     empty() const { return _keyframeCount == 0; }
+    [[nodiscard]] uint64_t getFirstTimestamp() const;
+
+private:
+    SharedMemory                   _memory;
+    const uint8_t*                 _data;        ///< The file start, offsets are relative to it
+    uint64_t                       _recordsEnd;  ///< Offset after the last record
+    const SnapshotArchiveKeyframe* _keyframes;
+    uint64_t                       _keyframeCount;
+};
\ No newline at end of file
@@ -0,0 +1,169 @@
+#include "StopOrders.h"
+
+#include <algorithm>
+
+StopOrders::StopOrders()
+{
+    updateBoundaries();
+}
+
+/**
+ *  @return true if stop at first price triggers after stop at second price: bid stop prices descend, ask ones ascend
+ */
+static bool isBefore(Order::Type      type,
+                     Order::PriceType first,
+                     Order::PriceType second)
+{
+    return type == Order::Type::Bid ? first > second : first < second;
+}
+
+size_t StopOrders::findLevel(Order::Type      type,
+                             Order::PriceType stopPrice) const
+{
+    const auto& sideStops = type == Order::Type::Bid ? _bids : _asks;
+    auto it = std::lower_bound(sideStops.prices.begin(), sideStops.prices.end(), stopPrice,
+                               [type](Order::PriceType first, Order::PriceType second)
+                               { return isBefore(type, first, second); });
+    if (it == sideStops.prices.end() || *it != stopPrice)
+        return sideStops.prices.size();
+    return it - sideStops.prices.begin();
+}
+
+void StopOrders::add(const StopOrder& stop)
+{
+    auto& sideStops = side(stop.type);
+    auto it = std::lower_bound(sideStops.prices.begin(), sideStops.prices.end(), stop.stopPrice,
+                               [&stop](Order::PriceType first, Order::PriceType second)
+                               { return isBefore(stop.type, first, second); });
+    auto level = it - sideStops.prices.begin();
+    if (it == sideStops.prices.end() || *it != stop.stopPrice)
+    {
+        sideStops.prices.insert(it, stop.stopPrice);
+        sideStops.queues.emplace(sideStops.queues.begin() + level);
+    }
+    sideStops.queues[level].push_back(stop);
+    _ids.emplace( stop.id, std::make_pair(stop.type, stop.stopPrice) );
+    updateBoundaries();
+}
+
+std::pair<bool, StopOrders::StopOrder> StopOrders::find(Order::IdType id) const
+{
+    auto idIt = _ids.find(id);
+    if (idIt == _ids.end())
+        return std::make_pair( false, StopOrder() );
+
+    const auto& sideStops = idIt->second.first == Order::Type::Bid ? _bids : _asks;
+    const auto& queue = sideStops.queues[ findLevel(idIt->second.first, idIt->second.second) ];
+    auto it = std::find_if(queue.begin(), queue.end(), [id](const StopOrder& stop) { return stop.id == id; });
+    assert(it != queue.end());
+    return std::make_pair(true, *it);
+}
+
+std::pair<bool, StopOrders::StopOrder> StopOrders::erase(Order::IdType id)
+{
+    auto idIt = _ids.find(id);
+    if (idIt == _ids.end())
+        return std::make_pair( false, StopOrder() );
+
+    auto& sideStops = side(idIt->second.first);
+    auto level = findLevel(idIt->second.first, idIt->second.second);
+    auto& queue = sideStops.queues[level];
+    auto it = std::find_if(queue.begin(), queue.end(), [id](const StopOrder& stop) { return stop.id == id; });
+    assert(it != queue.end());
+
+    auto stop = *it;
+    queue.erase(it);
+    if (queue.empty())
+    {
+        sideStops.prices.erase(sideStops.prices.begin() + level);
+        sideStops.queues.erase(sideStops.queues.begin() + level);
+    }
+    _ids.erase(idIt);
+    updateBoundaries();
+    return std::make_pair(true, stop);
+}
+
+size_t StopOrders::eraseOwner(Order::OwnerType        owner,
+                              std::vector<StopOrder>& erased)
+{
+    auto size = erased.size();
+    for (auto sideStops : {&_bids, &_asks})
+    {
+        for (auto level = sideStops->prices.size(); level-- > 0;)
+        {
+            auto& queue = sideStops->queues[level];
+            auto it = std::stable_partition(queue.begin(), queue.end(),
+                                            [owner](const StopOrder& stop) { return stop.owner != owner; });
+            for (auto stop = it; stop != queue.end(); ++stop)
+            {
+                _ids.erase(stop->id);
+                erased.push_back(*stop);
+            }
+            queue.erase( it, queue.end() );
+            if (queue.empty())
+            {
+                sideStops->prices.erase(sideStops->prices.begin() + level);
+                sideStops->queues.erase(sideStops->queues.begin() + level);
+            }
+        }
+    }
+    updateBoundaries();
+    return erased.size() - size;
+}
+
+void StopOrders::pop(Side& side)
+{
+    _ids.erase( side.queues.back().front().id );
+    side.queues.back().pop_front();
+    if (side.queues.back().empty())
+    {
+        side.prices.pop_back();
+        side.queues.pop_back();
+    }
+    updateBoundaries();
+}
+
+bool StopOrders::popTriggered(Order::PriceType low,
+                              Order::PriceType high,
+                              StopOrder&       stop)
+{
+    bool isBidTriggered = not _bids.prices.empty() && _bids.prices.back() <= high;
+    bool isAskTriggered = not _asks.prices.empty() && _asks.prices.back() >= low;
+    if (isBidTriggered && isAskTriggered)
+    {
+        if (_bids.queues.back().front().id < _asks.queues.back().front().id)
+            isAskTriggered = false;
+        else
+            isBidTriggered = false;
+    }
+
+    if (isBidTriggered)
+    {
+        stop = _bids.queues.back().front();
+        pop(_bids);
+        return true;
+    }
+    if (isAskTriggered)
+    {
+        stop = _asks.queues.back().front();
+        pop(_asks);
+        return true;
+    }
+    return false;
+}
+
+void StopOrders::clear()
+{
+    _bids.prices.clear();
+    _bids.queues.clear();
+    _asks.prices.clear();
+    _asks.queues.clear();
+    _ids.clear();
+    updateBoundaries();
+}
+
+void StopOrders::updateBoundaries()
+{
+    _bidBoundary = _bids.prices.empty() ? std::numeric_limits<Order::PriceType>::max() : _bids.prices.back();
+    _askBoundary = _asks.prices.empty() ? std::numeric_limits<Order::PriceType>::min() : _asks.prices.back();
+}
\ No newline at end of file
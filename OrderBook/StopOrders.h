@@ -0,0 +1,117 @@
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <limits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Order.h"
+
+/**
+ *  @brief Pending stop and stop-limit orders indexed by stop price per side
+ *
+ *  @details Bid stops trigger when trade price rises to their stop price, ask stops when it falls to it.
+ *           Every side keeps stop prices sorted with the next stop to trigger at the back and a FIFO queue
+ *           per stop price, so the trigger boundary of a side is its back price and checking a trade
+ *           against both boundaries takes O(1) regardless of the number of pending stops.
+ */
+class StopOrders
+{
+public:
+    struct StopOrder
+    {
+        Order::IdType       id        = 0;
+        Order::PriceType    stopPrice = 0;
+        Order::PriceType    price     = 0;  ///< Limit price of stop-limit order
+        Order::QuantityType quantity  = 0;
+        Order::OwnerType    owner     = Order::NoOwner;
+        Order::Type         type      = Order::Type::Bid;
+        bool                isLimit   = false;
+    };
+
+    StopOrders();
+
+    [[nodiscard]] size_t size () const { return _ids.size();  }
+    [[nodiscard]] bool   empty() const { return _ids.empty(); }
+
+    /**
+     *  @return true if trade at price triggers at least one stop
+     */
+    [[nodiscard]] bool triggers(Order::PriceType price) const
+    {
+        return price >= _bidBoundary || price <= _askBoundary;
+    }
+
+    /**
+     *  @brief Queue stop to the back of its stop price
+     */
+    void add(const StopOrder& stop);
+
+    /**
+     *  @return Pair of found flag and stop copy
+     */
+    std::pair<bool, StopOrder> find(Order::IdType id) const;
+
+    /**
+     *  @brief Remove stop
+     *
+     *  @return Pair of found flag and removed stop
+     */
+    std::pair<bool, StopOrder> erase(Order::IdType id);
+
+    /**
+     *  @brief Remove all stops of owner keeping the order of the rest
+     *
+     *  @return Number of removed stops, they are appended to erased
+     *
+     *  @details Takes time linear in the number of pending stops
+     */
+    size_t eraseOwner(Order::OwnerType        owner,
+                      std::vector<StopOrder>& erased);
+
+    /**
+     *  @brief Remove the next stop triggered by trades with prices in range [low, high]
+     *
+     *  @return false in case no stop is triggered
+     *
+     *  @details Stops of one side are removed in price/time order, in case both sides are triggered
+     *           the earlier added stop goes first
+     */
+    bool popTriggered(Order::PriceType low,
+                      Order::PriceType high,
+                      StopOrder&       stop);
+
+    void clear();
+
+private:
+    /**
+     *  @brief Stop prices sorted with the next to trigger at the back and parallel FIFO queues
+     */
+    struct Side
+    {
+        std::vector<Order::PriceType>      prices;
+        std::vector<std::deque<StopOrder>> queues;
+    };
+
+    Side _bids;
+    Side _asks;
+    std::unordered_map<Order::IdType, std::pair<Order::Type, Order::PriceType>> _ids;  ///< Side and stop price
+
+    /// The lowest bid and the highest ask stop price, values out of trade price range when a side is empty
+    Order::PriceType _bidBoundary;
+    Order::PriceType _askBoundary;
+
+    Side& side(Order::Type type) { return type == Order::Type::Bid ? _bids : _asks; }
+
+    /**
+     *  @return Index of stop price level or prices.size() in case it does not exist
+     */
+    size_t findLevel(Order::Type      type,
+                     Order::PriceType stopPrice) const;
+
+    void pop(Side& side);
+
+    void updateBoundaries();
+};
\ No newline at end of file
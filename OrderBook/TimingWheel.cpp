@@ -0,0 +1,151 @@
+#include "TimingWheel.h"
+
+#include <algorithm>
+
+constexpr unsigned TimingWheel::LevelBits;
+constexpr unsigned TimingWheel::Levels;
+constexpr unsigned TimingWheel::Buckets;
+constexpr unsigned TimingWheel::Words;
+
+/**
+ *  @return Level of the highest byte in which expiry differs from time
+ */
+static unsigned wheelLevel(Order::TimeType expiry,
+                           Order::TimeType time)
+{
+    return (63 - __builtin_clzll(expiry ^ time)) / 8;
+}
+
+static unsigned wheelBucket(Order::TimeType expiry,
+                            unsigned        level)
+{
+    return (expiry >> (8 * level)) & 0xff;
+}
+
+TimingWheel::TimingWheel()
+    : _time( 0 )
+{
+    clear();
+}
+
+void TimingWheel::clear()
+{
+    std::fill( &_heads[0][0], &_heads[0][0] + Levels * Buckets, OrderPool::InvalidSlot );
+    std::fill( &_occupied[0][0], &_occupied[0][0] + Levels * Words, 0 );
+}
+
+void TimingWheel::link(OrderPool&           pool,
+                       OrderPool::SlotIndex slot,
+                       Order::TimeType      expiry)
+{
+    assert(expiry > _time);
+    pool.timer(slot).expiry = expiry;
+    insert(pool, slot);
+}
+
+void TimingWheel::insert(OrderPool&           pool,
+                         OrderPool::SlotIndex slot)
+{
+    auto& timer = pool.timer(slot);
+    auto level  = wheelLevel(timer.expiry, _time);
+    auto bucket = wheelBucket(timer.expiry, level);
+
+    auto& head = _heads[level][bucket];
+    timer.prev = OrderPool::InvalidSlot;
+    timer.next = head;
+    if (head != OrderPool::InvalidSlot)
+        pool.timer(head).prev = slot;
+    head = slot;
+    _occupied[level][bucket / 64] |= uint64_t(1) << (bucket % 64);
+}
+
+void TimingWheel::unlink(OrderPool&           pool,
+                         OrderPool::SlotIndex slot)
+{
+    auto& timer = pool.timer(slot);
+    if (timer.expiry == Order::NoExpiry)
+        return;
+
+    /// Position is recomputed since linked orders always match the current time
+    auto level  = wheelLevel(timer.expiry, _time);
+    auto bucket = wheelBucket(timer.expiry, level);
+    if (timer.prev != OrderPool::InvalidSlot)
+        pool.timer(timer.prev).next = timer.next;
+    else
+        _heads[level][bucket] = timer.next;
+    if (timer.next != OrderPool::InvalidSlot)
+        pool.timer(timer.next).prev = timer.prev;
+
+    if (_heads[level][bucket] == OrderPool::InvalidSlot)
+        _occupied[level][bucket / 64] &= ~(uint64_t(1) << (bucket % 64));
+    timer.expiry = Order::NoExpiry;
+}
+
+void TimingWheel::drain(OrderPool& pool,
+                        unsigned   level,
+                        unsigned   first,
+                        unsigned   last)
+{
+    for (unsigned word = (first + 1) / 64; word <= last / 64; ++word)
+    {
+        auto bits = _occupied[level][word];
+        if (word == (first + 1) / 64)
+            bits &= ~uint64_t(0) << ((first + 1) % 64);
+        if (word == last / 64 && last % 64 != 63)
+            bits &= ( uint64_t(1) << (last % 64 + 1) ) - 1;
+
+        while (bits != 0)
+        {
+            auto bucket = word * 64 + __builtin_ctzll(bits);
+            bits &= bits - 1;
+            for (auto slot = _heads[level][bucket]; slot != OrderPool::InvalidSlot; slot = pool.timer(slot).next)
+                _drained.push_back(slot);
+            _heads[level][bucket] = OrderPool::InvalidSlot;
+            _occupied[level][word] &= ~(uint64_t(1) << (bucket % 64));
+        }
+    }
+}
+
+void TimingWheel::advance(OrderPool&                         pool,
+                          Order::TimeType                    now,
+                          std::vector<OrderPool::SlotIndex>& expired)
+{
+    if (now <= _time)
+        return;
+
+    /// Buckets between the old and the new time digits are passed. Where a higher byte changes,
+    /// every order of the level is due since it kept the old higher bytes
+    for (unsigned level = 0; level < Levels; ++level)
+    {
+        auto shift = level * LevelBits;
+        bool isSamePrefix = level + 1 == Levels || (_time >> (shift + LevelBits)) == (now >> (shift + LevelBits));
+        auto oldDigit = static_cast<unsigned>( (_time >> shift) & 0xff );
+        auto nowDigit = static_cast<unsigned>( (now   >> shift) & 0xff );
+        if (not isSamePrefix)
+            drain(pool, level, oldDigit, Buckets - 1);
+        else if (nowDigit > oldDigit)
+            drain(pool, level, oldDigit, nowDigit);
+    }
+    _time = now;
+
+    auto firstExpired = expired.size();
+    for (auto slot : _drained)
+    {
+        if (pool.timer(slot).expiry <= now)
+            expired.push_back(slot);
+        else
+            insert(pool, slot);
+    }
+    _drained.clear();
+
+    std::sort(expired.begin() + firstExpired, expired.end(),
+              [&pool](OrderPool::SlotIndex first, OrderPool::SlotIndex second)
+              {
+                  auto firstExpiry  = pool.timer(first) .expiry;
+                  auto secondExpiry = pool.timer(second).expiry;
+                  return firstExpiry != secondExpiry ? firstExpiry < secondExpiry
+                                                     : pool.cold(first).id < pool.cold(second).id;
+              });
+    for (auto it = expired.begin() + firstExpired; it != expired.end(); ++it)
+        pool.timer(*it).expiry = Order::NoExpiry;
+}
\ No newline at end of file
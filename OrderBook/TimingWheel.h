@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "OrderPool.h"
+
+/**
+ *  @brief Hierarchical timing wheel of resting orders with expiry time
+ *
+ *  @details Eight levels of 256 buckets cover the whole 64-bit time range. An order is kept at the level of
+ *           the highest byte in which its expiry differs from the current time, in the bucket of that byte.
+ *           Advancing time drains only passed non-empty buckets found by occupancy bitmaps, orders which are
+ *           not yet due move to a lower level, so every order moves at most eight times. Orders are linked
+ *           through OrderPool timer slots.
+ */
+class TimingWheel
+{
+public:
+    TimingWheel();
+
+    [[nodiscard]] Order::TimeType getTime() const { return _time; }
+
+    /**
+     *  @brief Link order kept in slot to the wheel
+     *
+     *  @note Expiry must be later than the current time
+     */
+    void link(OrderPool&           pool,
+              OrderPool::SlotIndex slot,
+              Order::TimeType      expiry);
+
+    /**
+     *  @brief Unlink order kept in slot, orders without expiry are not linked
+     */
+    void unlink(OrderPool&           pool,
+                OrderPool::SlotIndex slot);
+
+    /**
+     *  @brief Move current time forward and collect orders with expiry not later than now
+     *
+     *  @param expired Output, slots of expired orders ordered by expiry and ID, they are unlinked from the wheel
+     *
+     *  @details Time never moves backwards, earlier now is ignored
+     */
+    void advance(OrderPool&                         pool,
+                 Order::TimeType                    now,
+                 std::vector<OrderPool::SlotIndex>& expired);
+
+    /**
+     *  @brief Unlink all orders keeping the current time
+     */
+    void clear();
+
+private:
+    static constexpr unsigned LevelBits = 8;
+    static constexpr unsigned Levels    = 64 / LevelBits;
+    static constexpr unsigned Buckets   = 1 << LevelBits;
+    static constexpr unsigned Words     = Buckets / 64;
+
+    OrderPool::SlotIndex              _heads   [Levels][Buckets];
+    uint64_t                          _occupied[Levels][Words];  ///< Bit per non-empty bucket
+    Order::TimeType                   _time;
+    std::vector<OrderPool::SlotIndex> _drained;  ///< Orders of passed buckets, capacity is reused
+
+    /**
+     *  @brief Insert order by its expiry relative to the current time
+     */
+    void insert(OrderPool&           pool,
+                OrderPool::SlotIndex slot);
+
+    /**
+     *  @brief Move orders of non-empty buckets (first, last] of level to _drained
+     */
+    void drain(OrderPool& pool,
+               unsigned   level,
+               unsigned   first,
+               unsigned   last);
+};
\ No newline at end of file
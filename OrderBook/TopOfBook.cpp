@@ -0,0 +1,129 @@
+#include "TopOfBook.h"
+
+#include <algorithm>
+
+/**
+ *  @brief Account level of source in side of consolidated result, better price replaces, equal one adds up
+ */
+static void accountLevel(const OrderBook::PricePosition& level,
+                         size_t                          source,
+                         size_t                          sources,
+                         bool                            isBetter,
+                         bool&                           hasLevel,
+                         OrderBook::PricePosition&       best,
+                         size_t&                         bestSource,
+                         size_t&                         bestSources)
+{
+    if (not hasLevel || isBetter)
+    {
+        hasLevel    = true;
+        best        = level;
+        bestSource  = source;
+        bestSources = sources;
+    }
+    else if (level.price == best.price)
+    {
+        best.quantity += level.quantity;
+        bestSources   += sources;
+    }
+}
+
+/**
+ *  @brief Merge partial result of later sources into result
+ */
+static void merge(ConsolidatedTop&       result,
+                  const ConsolidatedTop& partial)
+{
+    if (partial.hasBid)
+        accountLevel(partial.bid, partial.bidSource, partial.bidSources,
+                     result.hasBid && partial.bid.price > result.bid.price,
+                     result.hasBid, result.bid, result.bidSource, result.bidSources);
+    if (partial.hasAsk)
+        accountLevel(partial.ask, partial.askSource, partial.askSources,
+                     result.hasAsk && partial.ask.price < result.ask.price,
+                     result.hasAsk, result.ask, result.askSource, result.askSources);
+}
+
+TopOfBookAggregator::TopOfBookAggregator(size_t threadCount,
+                                         size_t chunkSize)
+    : _chunkSize( std::max<size_t>(chunkSize, 1) )
+{
+    if (threadCount > 1)
+        _pool.reset( new WorkStealingPool(threadCount) );
+}
+
+size_t TopOfBookAggregator::addBook(const OrderBook& book)
+{
+    _sources.push_back( Source{&book, nullptr, MarketDataSnapshot()} );
+    _tops.emplace_back();
+    return _sources.size() - 1;
+}
+
+size_t TopOfBookAggregator::addReader(MarketDataReader& reader)
+{
+    _sources.push_back( Source{nullptr, &reader, MarketDataSnapshot()} );
+    _tops.emplace_back();
+    return _sources.size() - 1;
+}
+
+void TopOfBookAggregator::readChunk(size_t           first,
+                                    size_t           last,
+                                    ConsolidatedTop& partial)
+{
+    partial = ConsolidatedTop();
+    for (size_t i = first; i < last; ++i)
+    {
+        auto& source = _sources[i];
+        auto& top    = _tops[i];
+        top = TopOfBook();
+        if (source.book != nullptr)
+        {
+            auto bid = source.book->getBestPrice(Order::Type::Bid);
+            auto ask = source.book->getBestPrice(Order::Type::Ask);
+            top.hasBid  = bid.first;
+            top.bid     = bid.second;
+            top.hasAsk  = ask.first;
+            top.ask     = ask.second;
+            top.isValid = true;
+        }
+        else if ( source.reader->readSnapshot(source.snapshot) )
+        {
+            top.hasBid  = not source.snapshot.bids.empty();
+            top.hasAsk  = not source.snapshot.asks.empty();
+            if (top.hasBid)
+                top.bid = source.snapshot.bids.front();
+            if (top.hasAsk)
+                top.ask = source.snapshot.asks.front();
+            top.isValid = true;
+        }
+
+        if (top.hasBid)
+            accountLevel(top.bid, i, 1, partial.hasBid && top.bid.price > partial.bid.price,
+                         partial.hasBid, partial.bid, partial.bidSource, partial.bidSources);
+        if (top.hasAsk)
+            accountLevel(top.ask, i, 1, partial.hasAsk && top.ask.price < partial.ask.price,
+                         partial.hasAsk, partial.ask, partial.askSource, partial.askSources);
+    }
+}
+
+const ConsolidatedTop& TopOfBookAggregator::refresh()
+{
+    auto chunkCount = (_sources.size() + _chunkSize - 1) / _chunkSize;
+    _partials.resize(chunkCount);
+    for (size_t chunk = 0; chunk < chunkCount; ++chunk)
+    {
+        auto first = chunk * _chunkSize;
+        auto last  = std::min(first + _chunkSize, _sources.size());
+        if (_pool && chunkCount > 1)
+            _pool->submit([this, first, last, chunk]() { readChunk(first, last, _partials[chunk]); });
+        else
+            readChunk(first, last, _partials[chunk]);
+    }
+    if (_pool && chunkCount > 1)
+        _pool->wait();
+
+    _consolidated = ConsolidatedTop();
+    for (const auto& partial : _partials)
+        merge(_consolidated, partial);
+    return _consolidated;
+}
\ No newline at end of file
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "MarketDataRing.h"
+#include "OrderBook.h"
+#include "WorkStealingPool.h"
+
+/**
+ *  @brief L1 of one source as plain data
+ */
+struct TopOfBook
+{
+    OrderBook::PricePosition bid;
+    OrderBook::PricePosition ask;
+    bool                     hasBid  = false;
+    bool                     hasAsk  = false;
+    bool                     isValid = false;  ///< false in case the source could not be read consistently
+};
+
+/**
+ *  @brief The best prices over all sources
+ */
+struct ConsolidatedTop
+{
+    OrderBook::PricePosition bid;             ///< The best bid price and its total quantity over sources
+    OrderBook::PricePosition ask;
+    bool                     hasBid     = false;
+    bool                     hasAsk     = false;
+    size_t                   bidSource  = 0;  ///< The first source with the best bid
+    size_t                   askSource  = 0;
+    size_t                   bidSources = 0;  ///< Number of sources at the best bid
+    size_t                   askSources = 0;
+};
+
+/**
+ *  @brief Consolidated top of book over many order books or their published market data
+ *
+ *  @details refresh() reads L1 of every source into a flat array indexed by source, then reduces it to the
+ *           best prices. Sources are read in chunks on a work stealing pool when there are more of them than
+ *           one chunk, partial results are merged in source order, so the result does not depend on the
+ *           number of threads.
+ *
+ *  @note Books are read directly, so they must not be modified during refresh(). Books running on other
+ *        threads are added through their MarketDataPublisher rings
+ */
+class TopOfBookAggregator
+{
+public:
+    /**
+     *  @param threadCount Threads reading sources, 0 or 1 reads them on the calling thread
+     *  @param chunkSize   Number of sources read by one task
+     */
+    explicit TopOfBookAggregator(size_t threadCount = 1,
+                                 size_t chunkSize   = 64);
+
+    /**
+     *  @return Source index
+     */
+    size_t addBook(const OrderBook& book);
+
+    /**
+     *  @brief Add market data ring as source, the reader is used only by this aggregator
+     *
+     *  @details L1 is taken from the ring snapshot, so it is as fresh as the publisher snapshot interval
+     *
+     *  @return Source index
+     */
+    size_t addReader(MarketDataReader& reader);
+
+    [[nodiscard]] size_t size() const { return _sources.size(); }
+
+    /**
+     *  @brief Read all sources and consolidate them
+     */
+    const ConsolidatedTop& refresh();
+
+    /**
+     *  @return L1 of every source as of the last refresh(), indexed by source
+     */
+    [[nodiscard]] const std::vector<TopOfBook>& getTops() const { return _tops; }
+
+    [[nodiscard]] const ConsolidatedTop& getConsolidated() const { return _consolidated; }
+
+private:
+    struct Source
+    {
+        const OrderBook*   book;
+        MarketDataReader*  reader;
+        MarketDataSnapshot snapshot;  ///< Copy of the ring snapshot, capacity is reused
+    };
+
+    std::vector<Source>               _sources;
+    std::vector<TopOfBook>            _tops;
+    std::vector<ConsolidatedTop>      _partials;  ///< Result per chunk
+    ConsolidatedTop                   _consolidated;
+    size_t                            _chunkSize;
+    std::unique_ptr<WorkStealingPool> _pool;
+
+    /**
+     *  @brief Read sources [first, last) and reduce them to partial
+     */
+    void readChunk(size_t           first,
+                   size_t           last,
+                   ConsolidatedTop& partial);
+};
\ No newline at end of file
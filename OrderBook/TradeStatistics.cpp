@@ -0,0 +1,83 @@
+#include "TradeStatistics.h"
+
+#include <algorithm>
+
+void TradeStatistics::update(Order::PriceType    price,
+                             Order::QuantityType quantity)
+{
+    if (tradeCount == 0)
+        open = high = low = price;
+    else
+    {
+        high = std::max(high, price);
+        low  = std::min(low,  price);
+    }
+    close     = price;
+    volume   += quantity;
+    notional += static_cast<int64_t>(quantity) * price;
+    ++tradeCount;
+}
+
+double TradeStatistics::vwap() const
+{
+    return volume == 0 ? 0. : static_cast<double>(notional) / static_cast<double>(volume);
+}
+
+RollingTradeStatistics::RollingTradeStatistics(size_t windowSize)
+    : _windowSize( windowSize )
+    , _sequence  ( 0 )
+    , _volume    ( 0 )
+    , _notional  ( 0 )
+{
+    _trades.reserve(windowSize);
+}
+
+void RollingTradeStatistics::update(Order::PriceType    price,
+                                    Order::QuantityType quantity)
+{
+    if (_windowSize == 0)
+        return;
+
+    Trade trade{price, quantity, _sequence};
+    if (_trades.size() < _windowSize)
+        _trades.push_back(trade);
+    else
+    {
+        /// Evict the oldest trade of the window
+        auto& oldest = _trades[_sequence % _windowSize];
+        _volume   -= oldest.quantity;
+        _notional -= static_cast<int64_t>(oldest.quantity) * oldest.price;
+        if ( _highs.front().sequence == oldest.sequence )
+            _highs.pop_front();
+        if ( _lows.front().sequence == oldest.sequence )
+            _lows.pop_front();
+        oldest = trade;
+    }
+
+    _volume   += quantity;
+    _notional += static_cast<int64_t>(quantity) * price;
+    while ( not _highs.empty() && _highs.back().price <= price )
+        _highs.pop_back();
+    _highs.push_back(trade);
+    while ( not _lows.empty() && _lows.back().price >= price )
+        _lows.pop_back();
+    _lows.push_back(trade);
+    ++_sequence;
+}
+
+TradeStatistics RollingTradeStatistics::get() const
+{
+    TradeStatistics statistics;
+    if (_sequence == 0)
+        return statistics;
+
+    auto count = std::min<uint64_t>(_sequence, _windowSize);
+    statistics.open       = _trades[ (_sequence - count)  % _windowSize ].price;
+    statistics.close      = _trades[ (_sequence - 1)      % _windowSize ].price;
+    statistics.high       = _highs.front().price;
+    statistics.low        = _lows .front().price;
+    statistics.volume     = _volume;
+    statistics.notional   = _notional;
+    statistics.tradeCount = count;
+    return statistics;
+}
\ No newline at end of file
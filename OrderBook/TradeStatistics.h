@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <vector>
+
+#include "Order.h"
+
+/**
+ *  @brief Open, high, low, close, volume, notional and count of executed trades
+ */
+struct TradeStatistics
+{
+    Order::PriceType open       = 0;
+    Order::PriceType high       = 0;
+    Order::PriceType low        = 0;
+    Order::PriceType close      = 0;
+    uint64_t         volume     = 0;
+    int64_t          notional   = 0;  ///< Sum of price * quantity
+    uint64_t         tradeCount = 0;
+
+    /**
+     *  @brief Account trade in O(1)
+     */
+    void update(Order::PriceType    price,
+                Order::QuantityType quantity);
+
+    /**
+     *  @return Volume weighted average price, 0 in case there are no trades
+     */
+    [[nodiscard]] double vwap() const;
+};
+
+/**
+ *  @brief TradeStatistics over the last windowSize trades
+ *
+ *  @details Trades are added and evicted in amortized O(1), high and low are kept by monotonic queues
+ */
+class RollingTradeStatistics
+{
+public:
+    /**
+     *  @param windowSize Number of the last trades, 0 disables statistics
+     */
+    explicit RollingTradeStatistics(size_t windowSize = 0);
+
+    void update(Order::PriceType    price,
+                Order::QuantityType quantity);
+
+    [[nodiscard]] TradeStatistics get() const;
+
+    [[nodiscard]] size_t getWindowSize() const { return _windowSize; }
+
+private:
+    struct Trade
+    {
+        Order::PriceType    price;
+        Order::QuantityType quantity;
+        uint64_t            sequence;
+    };
+
+    size_t             _windowSize;
+    std::vector<Trade> _trades;     ///< Ring buffer of the last trades
+    uint64_t           _sequence;   ///< Number of trades ever accounted
+    uint64_t           _volume;
+    int64_t            _notional;
+    std::deque<Trade>  _highs;      ///< Decreasing prices of the window
+    std::deque<Trade>  _lows;       ///< Increasing prices of the window
+};
\ No newline at end of file
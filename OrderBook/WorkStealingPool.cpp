@@ -0,0 +1,129 @@
+#include "WorkStealingPool.h"
+
+#include <algorithm>
+
+/**
+ *  @brief Pool and worker index of the current thread, submissions of a worker go to its own queue
+ */
+static thread_local const WorkStealingPool* currentPool  = nullptr;
+static thread_local size_t                  currentIndex = 0;
+
+WorkStealingPool::WorkStealingPool(size_t threadCount)
+    : _nextWorker( 0 )
+    , _queued    ( 0 )
+    , _unfinished( 0 )
+    , _isStopping( false )
+{
+    if (threadCount == 0)
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    for (size_t i = 0; i < threadCount; ++i)
+        _workers.push_back( std::unique_ptr<Worker>(new Worker) );
+    for (size_t i = 0; i < threadCount; ++i)
+        _threads.emplace_back([this, i]() { run(i); });
+}
+
+WorkStealingPool::~WorkStealingPool()
+{
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _finished.wait(lock, [this]() { return _unfinished == 0; });
+        _isStopping = true;
+    }
+    _wakeUp.notify_all();
+    for (auto& thread : _threads)
+        thread.join();
+}
+
+void WorkStealingPool::submit(Task task)
+{
+    auto index = currentPool == this ? currentIndex : _nextWorker++ % _workers.size();
+    ++_unfinished;
+    ++_queued;
+    {
+        std::lock_guard<std::mutex> lock(_workers[index]->mutex);
+        _workers[index]->tasks.push_back( std::move(task) );
+    }
+
+    /// Taking the mutex orders the notification after the check of a worker going to sleep
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+    }
+    _wakeUp.notify_one();
+}
+
+void WorkStealingPool::wait()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    _finished.wait(lock, [this]() { return _unfinished == 0; });
+    if (_exception)
+    {
+        auto exception = _exception;
+        _exception = nullptr;
+        std::rethrow_exception(exception);
+    }
+}
+
+bool WorkStealingPool::tryTake(size_t index,
+                               Task&  task)
+{
+    {
+        auto& own = *_workers[index];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if ( not own.tasks.empty() )
+        {
+            task = std::move( own.tasks.front() );
+            own.tasks.pop_front();
+            --_queued;
+            return true;
+        }
+    }
+    for (size_t i = 1; i < _workers.size(); ++i)
+    {
+        auto& victim = *_workers[(index + i) % _workers.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if ( not victim.tasks.empty() )
+        {
+            task = std::move( victim.tasks.back() );
+            victim.tasks.pop_back();
+            --_queued;
+            return true;
+        }
+    }
+    return false;
+}
+
+void WorkStealingPool::run(size_t index)
+{
+    currentPool  = this;
+    currentIndex = index;
+    Task task;
+    while (true)
+    {
+        if ( tryTake(index, task) )
+        {
+            try
+            {
+                task();
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                if (not _exception)
+                    _exception = std::current_exception();
+            }
+            task = nullptr;
+
+            if (--_unfinished == 0)
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _finished.notify_all();
+            }
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(_mutex);
+        _wakeUp.wait(lock, [this]() { return _isStopping || _queued > 0; });
+        if (_isStopping)
+            return;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ *  @brief Thread pool where every worker has its own task queue and idle workers steal from the others
+ *
+ *  @details Tasks submitted from a worker go to the back of its own queue, external submissions are spread
+ *           round robin. A worker takes its oldest task first, so a task which resubmits its continuation
+ *           lets the other queued tasks run in between, thieves take the newest tasks.
+ */
+class WorkStealingPool
+{
+public:
+    using Task = std::function<void()>;
+
+    /**
+     *  @param threadCount Number of workers, 0 means the number of hardware threads
+     */
+    explicit WorkStealingPool(size_t threadCount = 0);
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator =(const WorkStealingPool&) = delete;
+
+    /**
+     *  @brief Wait for all tasks and stop workers
+     */
+    ~WorkStealingPool();
+
+    void submit(Task task);
+
+    /**
+     *  @brief Wait until all submitted tasks and tasks submitted by them are finished
+     *
+     *  @throws Rethrows the first exception thrown by a task
+     */
+    void wait();
+
+    [[nodiscard]] size_t getThreadCount() const { return _threads.size(); }
+
+private:
+    struct Worker
+    {
+        std::mutex       mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<Worker>> _workers;
+    std::vector<std::thread>             _threads;
+    std::atomic<size_t>                  _nextWorker;  ///< Round robin of external submissions
+    std::atomic<size_t>                  _queued;      ///< Tasks in queues
+    std::atomic<size_t>                  _unfinished;  ///< Tasks submitted and not finished
+
+    std::mutex              _mutex;      ///< Guards sleeping, stopping and the exception
+    std::condition_variable _wakeUp;
+    std::condition_variable _finished;
+    bool                    _isStopping;
+    std::exception_ptr      _exception;
+
+    void run(size_t index);
+
+    bool tryTake(size_t index,
+                 Task&  task);
+};
\ No newline at end of file
@@ -0,0 +1,68 @@
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+#include <EventFile.h>
+#include <Replayer.h>
+
+static int usage()
+{
+    std::cerr << "Usage:" << std::endl
+              << "    OrderBookReplay replay <events file> [speed]    speed 0 (default) is full speed, 1 is recorded pace"
+              << std::endl
+              << "    OrderBookReplay convert <csv file> <events file>" << std::endl;
+    return 2;
+}
+
+static int replay(const char* path,
+                  double      speed)
+{
+    EventFile events(path);
+    OrderBook book;
+    Replayer replayer(book);
+    auto stats = replayer.replay(events.begin(), events.end(), speed);
+
+    std::cout << "events:         " << stats.events  << std::endl
+              << "skipped:        " << stats.skipped << std::endl
+              << "seconds:        " << stats.seconds << std::endl
+              << "events/sec:     " << static_cast<uint64_t>( stats.eventsPerSecond() ) << std::endl
+              << "book checksum:  " << std::hex << std::setw(16) << std::setfill('0') << depthChecksum(book)
+              << std::endl;
+    return 0;
+}
+
+static int convert(const char* csvPath,
+                   const char* eventsPath)
+{
+    std::ifstream input(csvPath);
+    if (not input)
+    {
+        std::cerr << "Cannot open " << csvPath << std::endl;
+        return 1;
+    }
+    EventFileWriter writer(eventsPath);
+    auto converted = convertCsv(input, writer);
+    writer.close();
+    std::cout << "events: " << converted << std::endl;
+    return 0;
+}
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        if ( argc >= 3 && argc <= 4 && std::strcmp(argv[1], "replay") == 0 )
+            return replay( argv[2], argc == 4 ? std::atof(argv[3]) : 0 );
+        if ( argc == 4 && std::strcmp(argv[1], "convert") == 0 )
+            return convert(argv[2], argv[3]);
+        return usage();
+    }
+    catch (const std::exception& exception)
+    {
+        std::cerr << exception.what() << std::endl;
+        return 1;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "TestBook.h"
+
+TEST(AuctionTests, OrdersAccumulateWithoutMatching)  // NOLINT
+{
+    std::vector<Order> executedOrders;
+    OrderBook orderBook = testOrderBook([&executedOrders](Order order) { executedOrders.push_back(order); });
+    orderBook.startAuction();
+    ASSERT_TRUE( orderBook.isAuctionMode() );
+
+    auto id = orderBook.addOrder(Order::Type::Bid, 1003, 100);
+    ASSERT_TRUE( executedOrders.empty() );
+    ASSERT_EQ( orderBook.getOrderById(id).getQuantity(), 100 );
+
+    auto indicative = orderBook.getIndicativeAuctionResult();
+    ASSERT_EQ( indicative.price,    1003 );
+    ASSERT_EQ( indicative.quantity, 100  );
+}
+
+TEST(AuctionTests, Uncross)  // NOLINT
+{
+    std::vector<Order> executedOrders;
+    OrderBook orderBook([&executedOrders](Order order) { executedOrders.push_back(order); });
+    orderBook.startAuction();
+    orderBook.addOrder(Order::Type::Bid, 1010, 50);
+    orderBook.addOrder(Order::Type::Bid, 1005, 30);
+    orderBook.addOrder(Order::Type::Bid, 1000, 40);
+    orderBook.addOrder(Order::Type::Ask, 995,  20);
+    orderBook.addOrder(Order::Type::Ask, 1000, 40);
+    orderBook.addOrder(Order::Type::Ask, 1005, 60);
+
+    /// 1000: demand 120, supply 60; 1005: demand 80, supply 120
+    auto result = orderBook.uncross();
+    ASSERT_EQ( result.price,    1005 );
+    ASSERT_EQ( result.quantity, 80   );
+    ASSERT_FALSE( orderBook.isAuctionMode() );
+
+    for (const auto& order : executedOrders)
+        ASSERT_EQ( order.getPrice(), 1005 );
+    ASSERT_EQ( orderBook.getTradeStatistics().volume, 80 );
+
+    auto orderBookInfoJson = orderBook.getOrderBookInfoJson();
+    auto resultJson = R"V({
+    "asks": [
+        {
+            "price": 1005,
+            "quantity": 40
+        }
+    ],
+    "bids": [
+        {
+            "price": 1000,
+            "quantity": 40
+        }
+    ]
+}
+)V";
+    ASSERT_STREQ(orderBookInfoJson.c_str(), resultJson);
+
+    /// Continuous matching is restored
+    orderBook.addOrder(Order::Type::Bid, 1005, 10);
+    ASSERT_EQ( orderBook.getDepthQuantity(Order::Type::Ask), 30 );
+}
+
+TEST(AuctionTests, NotCrossed)  // NOLINT
+{
+    OrderBook orderBook = testOrderBook();
+    orderBook.startAuction();
+    auto result = orderBook.uncross();
+    ASSERT_EQ( result.quantity, 0 );
+    ASSERT_FALSE( orderBook.isAuctionMode() );
+    ASSERT_EQ( orderBook.getDepthQuantity(Order::Type::Ask), 150 );
+}
\ No newline at end of file
@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <Backtest.h>
+#include <WorkStealingPool.h>
+
+static std::vector<ReplayEvent> randomFlow(size_t   size,
+                                           uint32_t seed)
+{
+    std::mt19937 random(seed);
+    std::vector<ReplayEvent> events;
+    for (uint64_t i = 1; i <= size; ++i)
+    {
+        ReplayEvent event{};
+        event.timestamp = i;
+        if (i > 1 && random() % 4 == 0)
+        {
+            event.kind = ReplayEvent::Kind::Cancel;
+            event.id   = 1 + random() % (i - 1);
+        }
+        else
+        {
+            event.kind     = ReplayEvent::Kind::Add;
+            event.id       = i;
+            event.type     = random() % 2 ? Order::Type::Bid : Order::Type::Ask;
+            event.price    = 1000 + static_cast<Order::PriceType>(random() % 11) - 5;
+            event.quantity = 1 + random() % 50;
+        }
+        events.push_back(event);
+    }
+    return events;
+}
+
+static void expectEqual(const BacktestResult& first,
+                        const BacktestResult& second)
+{
+    ASSERT_EQ( first.name,     second.name     );
+    ASSERT_EQ( first.events,   second.events   );
+    ASSERT_EQ( first.skipped,  second.skipped  );
+    ASSERT_EQ( first.checksum, second.checksum );
+    ASSERT_EQ( first.executions.size(), second.executions.size() );
+    for (size_t i = 0; i < first.executions.size(); ++i)
+    {
+        ASSERT_EQ( first.executions[i].id,       second.executions[i].id       );
+        ASSERT_EQ( first.executions[i].type,     second.executions[i].type     );
+        ASSERT_EQ( first.executions[i].price,    second.executions[i].price    );
+        ASSERT_EQ( first.executions[i].quantity, second.executions[i].quantity );
+    }
+}
+
+TEST(BacktestTests, ResultsDoNotDependOnThreads)  // NOLINT
+{
+    std::vector<std::vector<ReplayEvent>> flows;
+    std::vector<BacktestJob> jobs;
+    for (uint32_t i = 0; i < 8; ++i)
+        flows.push_back( randomFlow(i == 0 ? 20000 : 500 + 300 * i, i) );  // One long history
+    for (size_t i = 0; i < flows.size(); ++i)
+        jobs.push_back( BacktestJob{"instrument" + std::to_string(i), flows[i].data(), flows[i].data() + flows[i].size()} );
+
+    auto sequential = runBacktest(jobs, 1);
+    auto parallel   = runBacktest(jobs, 4, 100);
+    ASSERT_EQ( sequential.size(), jobs.size() );
+    ASSERT_EQ( parallel  .size(), jobs.size() );
+    for (size_t i = 0; i < jobs.size(); ++i)
+        expectEqual(sequential[i], parallel[i]);
+
+    /// Single replay of the same flow
+    OrderBook book;
+    Replayer replayer(book);
+    auto stats = replayer.replay(jobs[3].begin, jobs[3].end);
+    ASSERT_EQ( parallel[3].events,   stats.events        );
+    ASSERT_EQ( parallel[3].checksum, depthChecksum(book) );
+    ASSERT_FALSE( parallel[3].executions.empty() );
+}
+
+TEST(BacktestTests, PoolRunsNestedTasks)  // NOLINT
+{
+    std::atomic<int> counter(0);
+    WorkStealingPool pool(3);
+    for (int i = 0; i < 10; ++i)
+        pool.submit([&pool, &counter]()
+        {
+            ++counter;
+            for (int j = 0; j < 10; ++j)
+                pool.submit([&counter]() { ++counter; });
+        });
+    pool.wait();
+    ASSERT_EQ( counter, 110 );
+}
+
+TEST(BacktestTests, PoolRethrowsTaskException)  // NOLINT
+{
+    WorkStealingPool pool(2);
+    pool.submit([]() { throw std::runtime_error("task failed"); });
+    pool.submit([]() {});
+    ASSERT_THROW(pool.wait(), std::runtime_error);
+    pool.submit([]() {});
+    pool.wait();
+}
\ No newline at end of file
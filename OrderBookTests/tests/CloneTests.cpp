@@ -0,0 +1,53 @@
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "TestBook.h"
+
+TEST(CloneTests, CloneIsIndependent)  // NOLINT
+{
+    std::vector<Order> executedOrders;
+    OrderBook orderBook = testOrderBook([&executedOrders](Order order) { executedOrders.push_back(order); });
+    auto id = orderBook.addOrder(Order::Type::Ask, 1002, 10);
+    auto snapshot = orderBook.marketDataL2JsonSnapshot();
+
+    std::vector<Order> simulatedOrders;
+    auto copy = orderBook.clone([&simulatedOrders](Order order) { simulatedOrders.push_back(order); });
+    ASSERT_EQ( copy.marketDataL2JsonSnapshot(), snapshot );
+
+    copy.addOrder(Order::Type::Bid, 1002, 100);
+    ASSERT_FALSE( simulatedOrders.empty() );
+    ASSERT_TRUE ( executedOrders.empty() );
+    ASSERT_FALSE( copy.findOrderById(id).first );
+
+    ASSERT_EQ( orderBook.marketDataL2JsonSnapshot(), snapshot );
+    ASSERT_EQ( orderBook.getOrderById(id).getQuantity(), 10 );
+}
+
+TEST(CloneTests, HandlesResolveInClone)  // NOLINT
+{
+    OrderBook orderBook;
+    auto handle = orderBook.addOrderWithHandle(Order::Type::Bid, 1000, 100);
+    auto copy = orderBook.clone();
+
+    copy.cancelOrder(handle);
+    ASSERT_FALSE( copy.findOrderById(handle).first );
+    ASSERT_EQ( orderBook.getOrderById(handle).getQuantity(), 100 );
+}
+
+TEST(CloneTests, CopyStateKeepsCallbacks)  // NOLINT
+{
+    OrderBook orderBook = testOrderBook();
+    orderBook.addOrder(Order::Type::Ask, 1500, 10);
+
+    std::vector<Order> simulatedOrders;
+    OrderBook scratch([&simulatedOrders](Order order) { simulatedOrders.push_back(order); });
+    for (int i = 0; i < 3; ++i)
+    {
+        scratch.copyStateFrom(orderBook);
+        ASSERT_EQ( scratch.marketDataL2JsonSnapshot(), orderBook.marketDataL2JsonSnapshot() );
+        scratch.addOrder(Order::Type::Bid, 1500, 1000);
+    }
+    ASSERT_FALSE( simulatedOrders.empty() );
+    ASSERT_EQ( simulatedOrders.size() % 3, 0 );
+    ASSERT_NE( scratch.marketDataL2JsonSnapshot(), orderBook.marketDataL2JsonSnapshot() );
+}
\ No newline at end of file
@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+#include <DepthKernels.h>
+
+#include "TestBook.h"
+
+using SumFunction        = uint64_t (*)(const Order::TotalQuantityType*, size_t);
+using CumulativeFunction = void     (*)(const Order::TotalQuantityType*, size_t, uint64_t*);
+
+/**
+ *  @brief Compare kernels with the scalar reference for every count around the vector widths
+ */
+static void checkKernels(SumFunction        sum,
+                         CumulativeFunction cumulativeFromBack,
+                         const char*        name)
+{
+    std::mt19937 random(7);
+    for (size_t count = 0; count < 70; ++count)
+    {
+        std::vector<Order::TotalQuantityType> quantities(count);
+        for (auto& quantity : quantities)
+            quantity = random();  // Large values check 64-bit accumulation
+
+        ASSERT_EQ( sum( quantities.data(), count ),
+                   DepthKernels::sumScalar( quantities.data(), count ) ) << name;
+
+        std::vector<uint64_t> result(count), expected(count);
+        cumulativeFromBack( quantities.data(), count, result.data() );
+        DepthKernels::cumulativeFromBackScalar( quantities.data(), count, expected.data() );
+        ASSERT_EQ(result, expected) << name;
+    }
+}
+
+TEST(DepthKernelsTests, MatchScalar)  // NOLINT
+{
+    checkKernels( DepthKernels::sum, DepthKernels::cumulativeFromBack, DepthKernels::instructionSet() );
+}
+
+TEST(DepthKernelsTests, Sse2MatchesScalar)  // NOLINT
+{
+#ifdef DEPTH_KERNELS_X86
+    checkKernels( DepthKernels::sumSse2, DepthKernels::cumulativeFromBackSse2, "sse2" );
+#else
+    GTEST_SKIP() << "SSE2 kernels are built on x86-64 only";
+#endif
+}
+
+TEST(DepthKernelsTests, Avx2MatchesScalar)  // NOLINT
+{
+#ifdef DEPTH_KERNELS_X86
+    if ( not DepthKernels::isAvx2Supported() )
+        GTEST_SKIP() << "CPU does not support AVX2";
+    checkKernels( DepthKernels::sumAvx2, DepthKernels::cumulativeFromBackAvx2, "avx2" );
+#else
+    GTEST_SKIP() << "AVX2 kernels are built on x86-64 only";
+#endif
+}
+
+TEST(DepthKernelsTests, OrderBookDepth)  // NOLINT
+{
+    OrderBook orderBook = testOrderBook();
+    ASSERT_EQ( orderBook.getDepthQuantity(Order::Type::Ask),    150 );
+    ASSERT_EQ( orderBook.getDepthQuantity(Order::Type::Bid, 2), 119 );
+    ASSERT_EQ( orderBook.getDepthQuantity(Order::Type::Bid, 0), 0   );
+
+    std::vector<uint64_t> depth;
+    orderBook.getCumulativeDepth(Order::Type::Ask, -1, depth);
+    ASSERT_EQ( depth, std::vector<uint64_t>({30, 60, 150}) );
+    orderBook.getCumulativeDepth(Order::Type::Bid, 2, depth);
+    ASSERT_EQ( depth, std::vector<uint64_t>({40, 119}) );
+}
\ No newline at end of file
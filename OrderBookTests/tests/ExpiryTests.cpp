@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+#include <map>
+#include <random>
+#include <vector>
+
+#include "TestBook.h"
+
+TEST(ExpiryTests, OrdersExpireInBatch)  // NOLINT
+{
+    std::vector<std::vector<Order>> batches;
+    OrderBook orderBook(nullptr, nullptr,
+                        [&batches](const std::vector<Order>& orders) { batches.push_back(orders); });
+    auto late  = orderBook.addOrder(Order::Type::Bid, 1000, 10, Order::NoOwner, 300);
+    auto early = orderBook.addOrder(Order::Type::Ask, 1100, 10, Order::NoOwner, 100);
+    auto gtc   = orderBook.addOrder(Order::Type::Ask, 1200, 10);
+
+    ASSERT_EQ( orderBook.advanceTime(99), 0 );
+    ASSERT_TRUE( batches.empty() );
+    ASSERT_EQ( orderBook.advanceTime(300), 2 );
+    ASSERT_EQ( orderBook.getTime(), 300 );
+    ASSERT_EQ( batches.size(),    1 );
+    ASSERT_EQ( batches[0].size(), 2 );
+    ASSERT_EQ( batches[0][0].getId(), early );
+    ASSERT_EQ( batches[0][1].getId(), late  );
+    ASSERT_FALSE( orderBook.findOrderById(late).first );
+    ASSERT_TRUE ( orderBook.findOrderById(gtc) .first );
+
+    /// Time does not move backwards
+    ASSERT_EQ( orderBook.advanceTime(10), 0 );
+    ASSERT_EQ( orderBook.getTime(), 300 );
+}
+
+TEST(ExpiryTests, RemovedOrdersDoNotExpire)  // NOLINT
+{
+    std::vector<Order> canceledOrders;
+    OrderBook orderBook(nullptr, [&canceledOrders](Order order) { canceledOrders.push_back(order); });
+    auto canceled = orderBook.addOrder(Order::Type::Bid, 1000, 10, Order::NoOwner, 50);
+    auto executed = orderBook.addOrder(Order::Type::Bid, 1001, 10, Order::NoOwner, 50);
+    auto amended  = orderBook.addOrder(Order::Type::Bid, 999,  10, Order::NoOwner, 50);
+    orderBook.cancelOrder(canceled);
+    orderBook.addOrder(Order::Type::Ask, 1001, 10);
+    orderBook.amendOrder(amended, 998, 20);  // Expiry is kept
+    canceledOrders.clear();
+
+    ASSERT_EQ( orderBook.advanceTime(1000), 1 );
+    ASSERT_EQ( canceledOrders.size(), 1 );
+    ASSERT_EQ( canceledOrders[0].getId(), amended );
+    ASSERT_FALSE( orderBook.findOrderById(executed).first );
+}
+
+TEST(ExpiryTests, ExpiredOnAddDoesNotRest)  // NOLINT
+{
+    std::vector<Order> executedOrders;
+    std::vector<Order> canceledOrders;
+    OrderBook orderBook([&executedOrders](Order order) { executedOrders.push_back(order); },
+                        [&canceledOrders](Order order) { canceledOrders.push_back(order); });
+    orderBook.addOrder(Order::Type::Ask, 1000, 5);
+    orderBook.advanceTime(100);
+
+    auto handle = orderBook.addOrderWithHandle(Order::Type::Bid, 1000, 15, Order::NoOwner, 100);
+    ASSERT_EQ( executedOrders.size(), 2 );
+    ASSERT_EQ( canceledOrders.size(), 1 );
+    ASSERT_EQ( canceledOrders[0].getQuantity(), 10 );
+    ASSERT_EQ( handle.slot, OrderPool::InvalidSlot );
+    ASSERT_FALSE( orderBook.findOrderById(handle.id).first );
+}
+
+TEST(ExpiryTests, CancelAllClearsExpiries)  // NOLINT
+{
+    OrderBook orderBook;
+    orderBook.addOrder(Order::Type::Bid, 1000, 10, Order::NoOwner, 500);
+    orderBook.cancelAllOrders();
+    auto id = orderBook.addOrder(Order::Type::Bid, 1000, 10);
+    ASSERT_EQ( orderBook.advanceTime(1000), 0 );
+    ASSERT_TRUE( orderBook.findOrderById(id).first );
+}
+
+TEST(ExpiryTests, RandomAgainstBruteForce)  // NOLINT
+{
+    std::mt19937_64 random(42);
+    OrderBook orderBook;
+    std::map<Order::IdType, Order::TimeType> expiries;  ///< Expected live orders with expiry
+    Order::TimeType now = 0;
+
+    for (int step = 0; step < 20000; ++step)
+    {
+        auto roll = random() % 10;
+        if (roll < 6)
+        {
+            /// Expiries of different magnitudes exercise every wheel level
+            auto magnitude = 1 + random() % 40;
+            auto expiry = now + 1 + random() % (uint64_t(1) << magnitude);
+            auto id = orderBook.addOrder(Order::Type::Bid, 1000 - static_cast<Order::PriceType>(step % 100), 1,
+                                         Order::NoOwner, expiry);
+            expiries[id] = expiry;
+        }
+        else if (roll < 8 && not expiries.empty())
+        {
+            auto it = expiries.begin();
+            std::advance( it, random() % expiries.size() );
+            orderBook.cancelOrder(it->first);
+            expiries.erase(it);
+        }
+        else
+        {
+            now += random() % ( uint64_t(1) << (1 + random() % 36) );
+            size_t expected = 0;
+            for (auto it = expiries.begin(); it != expiries.end();)
+            {
+                if (it->second <= now)
+                {
+                    it = expiries.erase(it);
+                    ++expected;
+                }
+                else
+                    ++it;
+            }
+            ASSERT_EQ( orderBook.advanceTime(now), expected ) << "step " << step;
+        }
+    }
+    for (const auto& expiry : expiries)
+        ASSERT_TRUE( orderBook.findOrderById(expiry.first).first );
+}
\ No newline at end of file
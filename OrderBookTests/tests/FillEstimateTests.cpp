@@ -0,0 +1,63 @@
+#include <gtest/gtest.h>
+
+#include "TestBook.h"
+
+TEST(FillEstimateTests, EstimateFill)  // NOLINT
+{
+    OrderBook orderBook = testOrderBook();
+
+    auto estimate = orderBook.estimateFill(Order::Type::Bid, 45);
+    ASSERT_EQ( estimate.quantity, 45                    );
+    ASSERT_EQ( estimate.notional, 30 * 1001 + 15 * 1002 );
+
+    estimate = orderBook.estimateFill(Order::Type::Ask, 100);
+    ASSERT_EQ( estimate.quantity, 100                 );
+    ASSERT_EQ( estimate.notional, 40 * 999 + 60 * 900 );
+
+    estimate = orderBook.estimateFill(Order::Type::Bid, 1000);
+    ASSERT_EQ( estimate.quantity, 150                                 );
+    ASSERT_EQ( estimate.notional, 30 * 1001 + 30 * 1002 + 90 * 1003 );
+
+    estimate = orderBook.estimateFill(Order::Type::Bid, 0);
+    ASSERT_EQ( estimate.quantity, 0 );
+    ASSERT_EQ( estimate.notional, 0 );
+}
+
+TEST(FillEstimateTests, EstimateFillUpToPrice)  // NOLINT
+{
+    OrderBook orderBook = testOrderBook();
+
+    auto estimate = orderBook.estimateFillUpToPrice(Order::Type::Bid, 1002);
+    ASSERT_EQ( estimate.quantity, 60                    );
+    ASSERT_EQ( estimate.notional, 30 * 1001 + 30 * 1002 );
+
+    estimate = orderBook.estimateFillUpToPrice(Order::Type::Ask, 850);
+    ASSERT_EQ( estimate.quantity, 119                 );
+    ASSERT_EQ( estimate.notional, 40 * 999 + 79 * 900 );
+
+    estimate = orderBook.estimateFillUpToPrice(Order::Type::Bid, 1000);
+    ASSERT_EQ( estimate.quantity, 0 );
+
+    estimate = orderBook.estimateFillUpToPrice(Order::Type::Ask, 1);
+    ASSERT_EQ( estimate.quantity, 174 );
+}
+
+TEST(FillEstimateTests, MatchesExecution)  // NOLINT
+{
+    OrderBook orderBook = testOrderBook();
+    auto estimate = orderBook.estimateFillUpToPrice(Order::Type::Bid, 1002);
+
+    int64_t notional = 0;
+    uint64_t quantity = 0;
+    OrderBook executionBook = testOrderBook([&](Order order)
+            {
+                if (order.getType() == Order::Type::Ask)
+                {
+                    quantity += order.getQuantity();
+                    notional += static_cast<int64_t>( order.getQuantity() ) * order.getPrice();
+                }
+            });
+    executionBook.addOrder(Order::Type::Bid, 1002, 1000);
+    ASSERT_EQ( estimate.quantity, quantity );
+    ASSERT_EQ( estimate.notional, notional );
+}
\ No newline at end of file
@@ -0,0 +1,182 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <map>
+#include <random>
+#include <vector>
+
+#include "TestBook.h"
+
+/**
+ *  @brief Book rebuilt from L3 snapshot and events
+ */
+struct L3Book
+{
+    struct Entry
+    {
+        Order::Type         type;
+        Order::PriceType    price;
+        Order::QuantityType quantity;
+        uint64_t            arrival;  ///< Sequence of Add event or position in snapshot
+    };
+
+    std::map<Order::IdType, Entry> orders;
+    uint64_t                       sequence = 0;
+
+    void load(const OrderBook& book)
+    {
+        orders.clear();
+        std::vector<OrderBook::QueuedOrder> queued;
+        for (auto type : {Order::Type::Bid, Order::Type::Ask})
+        {
+            book.getQueuedOrders(type, -1, queued);
+            for (const auto& order : queued)
+                orders[order.id] = Entry{type, order.price, order.quantity, order.queuePosition};
+        }
+        sequence = book.getL3Sequence();
+    }
+
+    void apply(const OrderBook::L3Event& event)
+    {
+        if (event.sequence <= sequence)
+            return;
+        ASSERT_EQ( event.sequence, sequence + 1 );
+        sequence = event.sequence;
+        switch (event.kind)
+        {
+        case OrderBook::L3Event::Kind::Add:
+            ASSERT_EQ( orders.count(event.id), 0 );
+            orders[event.id] = Entry{event.type, event.price, event.quantity, event.sequence};
+            break;
+        case OrderBook::L3Event::Kind::Reduce:
+            ASSERT_EQ( orders.count(event.id), 1 );
+            ASSERT_LT( event.quantity, orders[event.id].quantity );
+            orders[event.id].quantity = event.quantity;
+            break;
+        case OrderBook::L3Event::Kind::Remove:
+            ASSERT_EQ( orders.erase(event.id), 1 );
+            break;
+        }
+    }
+
+    /**
+     *  @brief Orders of side in priority order, valid when the whole queue arrived by events or snapshot
+     */
+    [[nodiscard]] std::vector<Order::IdType> queue(Order::Type type) const
+    {
+        std::vector<std::pair<Order::IdType, Entry>> side;
+        for (const auto& order : orders)
+            if (order.second.type == type)
+                side.push_back(order);
+        std::sort(side.begin(), side.end(),
+                  [type](const std::pair<Order::IdType, Entry>& left, const std::pair<Order::IdType, Entry>& right)
+                  {
+                      if (left.second.price != right.second.price)
+                          return type == Order::Type::Bid ? left.second.price > right.second.price
+                                                          : left.second.price < right.second.price;
+                      return left.second.arrival < right.second.arrival;
+                  });
+        std::vector<Order::IdType> ids;
+        for (const auto& order : side)
+            ids.push_back(order.first);
+        return ids;
+    }
+};
+
+static std::vector<Order::IdType> queuedIds(const OrderBook& book,
+                                            Order::Type      type)
+{
+    std::vector<OrderBook::QueuedOrder> queued;
+    book.getQueuedOrders(type, -1, queued);
+    std::vector<Order::IdType> ids;
+    for (const auto& order : queued)
+        ids.push_back(order.id);
+    return ids;
+}
+
+TEST(L3Tests, QueuedOrdersInPriority)  // NOLINT
+{
+    OrderBook orderBook;
+    auto first  = orderBook.addOrder(Order::Type::Bid, 1000, 10);
+    auto better = orderBook.addOrder(Order::Type::Bid, 1001, 5);
+    auto second = orderBook.addOrder(Order::Type::Bid, 1000, 7);
+    orderBook.addOrder(Order::Type::Bid, 999, 1);
+
+    std::vector<OrderBook::QueuedOrder> queued;
+    orderBook.getQueuedOrders(Order::Type::Bid, 2, queued);
+    ASSERT_EQ( queued.size(), 3 );
+    ASSERT_EQ( queued[0].id,            better );
+    ASSERT_EQ( queued[0].queuePosition, 0 );
+    ASSERT_EQ( queued[1].id,            first );
+    ASSERT_EQ( queued[1].price,         1000 );
+    ASSERT_EQ( queued[1].quantity,      10 );
+    ASSERT_EQ( queued[2].id,            second );
+    ASSERT_EQ( queued[2].queuePosition, 1 );
+
+    orderBook.getQueuedOrders(Order::Type::Ask, -1, queued);
+    ASSERT_TRUE( queued.empty() );
+}
+
+TEST(L3Tests, EventsKeepCopyInSync)  // NOLINT
+{
+    OrderBook orderBook;
+    std::vector<OrderBook::L3Event> events;
+    orderBook.setL3Callback([&events](const OrderBook::L3Event& event) { events.push_back(event); });
+
+    std::mt19937 random(9);
+    std::vector<Order::IdType> ids;
+    L3Book copy;
+    for (int i = 0; i < 4000; ++i)
+    {
+        /// Late subscriber takes snapshot, then applies only newer events
+        if (i == 1500)
+        {
+            copy.load(orderBook);
+            events.clear();
+        }
+
+        auto action = random() % 10;
+        auto type   = random() % 2 ? Order::Type::Bid : Order::Type::Ask;
+        auto price  = static_cast<Order::PriceType>( 1000 + random() % 20 );
+        auto owner  = static_cast<Order::OwnerType>( 1 + random() % 4 );
+        if (action < 5 || ids.empty())
+            ids.push_back( orderBook.addOrder(type, price, 1 + random() % 10, owner) );
+        else if (action < 7)
+            orderBook.tryCancelOrder( ids[random() % ids.size()] );
+        else if (action < 9)
+        {
+            auto id = ids[random() % ids.size()];
+            if (orderBook.findOrderById(id).first)
+                orderBook.amendOrder(id, price, 1 + random() % 10);
+        }
+        else if (random() % 2)
+            orderBook.cancelAllForOwner(owner);
+        else
+            ids.push_back( orderBook.addStopOrder(type, price, 1 + random() % 10) );
+
+        if (i >= 1500)
+        {
+            for (const auto& event : events)
+                copy.apply(event);
+            events.clear();
+        }
+    }
+
+    ASSERT_EQ( copy.sequence, orderBook.getL3Sequence() );
+    for (auto type : {Order::Type::Bid, Order::Type::Ask})
+    {
+        std::vector<OrderBook::QueuedOrder> queued;
+        orderBook.getQueuedOrders(type, -1, queued);
+        ASSERT_EQ( copy.queue(type), queuedIds(orderBook, type) );
+        for (const auto& order : queued)
+        {
+            ASSERT_EQ( copy.orders[order.id].price,    order.price );
+            ASSERT_EQ( copy.orders[order.id].quantity, order.quantity );
+        }
+    }
+
+    /// Mass cancel removes every order
+    orderBook.cancelAllOrders();
+    for (const auto& event : events)
+        copy.apply(event);
+    ASSERT_TRUE( copy.orders.empty() );
+}
\ No newline at end of file
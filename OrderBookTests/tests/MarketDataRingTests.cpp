@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+#include <map>
+#include <string>
+#include <system_error>
+#include <unistd.h>
+
+#include <MarketDataRing.h>
+
+#include "TestBook.h"
+
+static std::string ringName(const char* test)
+{
+    return "/orderbook_md_" + std::string(test) + '_' + std::to_string( getpid() );
+}
+
+/**
+ *  @brief Book state rebuilt by a reader from snapshot and events
+ */
+struct ReaderBook
+{
+    std::map<Order::PriceType, Order::QuantityType> bids;
+    std::map<Order::PriceType, Order::QuantityType> asks;
+    OrderBook::PricePosition                        bestBid;
+    OrderBook::PricePosition                        bestAsk;
+    OrderBook::PricePosition                        lastTransaction;
+
+    void apply(const MarketDataEvent& event)
+    {
+        auto& levels = event.side == Order::Type::Bid ? bids : asks;
+        switch (event.kind)
+        {
+            case MarketDataEvent::Kind::BestPrice:
+                ( event.side == Order::Type::Bid ? bestBid : bestAsk ) = OrderBook::PricePosition{event.price, event.quantity};
+                break;
+            case MarketDataEvent::Kind::Level:
+                if (event.quantity == 0)
+                    levels.erase(event.price);
+                else
+                    levels[event.price] = event.quantity;
+                break;
+            case MarketDataEvent::Kind::LastTransaction:
+                lastTransaction = OrderBook::PricePosition{event.price, event.quantity};
+                break;
+        }
+    }
+
+    void apply(const MarketDataSnapshot& snapshot)
+    {
+        bids.clear();
+        asks.clear();
+        for (const auto& level : snapshot.bids)
+            bids[level.price] = level.quantity;
+        for (const auto& level : snapshot.asks)
+            asks[level.price] = level.quantity;
+        bestBid = snapshot.bids.empty() ? OrderBook::PricePosition() : snapshot.bids.front();
+        bestAsk = snapshot.asks.empty() ? OrderBook::PricePosition() : snapshot.asks.front();
+        lastTransaction = snapshot.lastTransaction;
+    }
+
+    void expectEqual(const OrderBook& book,
+                     int              depth) const
+    {
+        std::vector<OrderBook::PricePosition> levels;
+        book.getPriceLevels(Order::Type::Bid, depth, levels);
+        ASSERT_EQ( bids.size(), levels.size() );
+        for (const auto& level : levels)
+            ASSERT_EQ( bids.at(level.price), level.quantity );
+        ASSERT_EQ( bestBid.price, levels.empty() ? 0 : levels[0].price );
+
+        book.getPriceLevels(Order::Type::Ask, depth, levels);
+        ASSERT_EQ( asks.size(), levels.size() );
+        for (const auto& level : levels)
+            ASSERT_EQ( asks.at(level.price), level.quantity );
+        ASSERT_EQ( bestAsk.price, levels.empty() ? 0 : levels[0].price );
+
+        ASSERT_EQ( lastTransaction.price,    book.getLastTransaction().second.price    );
+        ASSERT_EQ( lastTransaction.quantity, book.getLastTransaction().second.quantity );
+    }
+};
+
+TEST(MarketDataRingTests, EventsRebuildDepth)  // NOLINT
+{
+    auto name = ringName("events");
+    MarketDataPublisher publisher(name, 1024, 3);
+    MarketDataReader reader(name);
+    ReaderBook readerBook;
+
+    OrderBook orderBook = testOrderBook();
+    publisher.publish(orderBook);
+    orderBook.addOrder(Order::Type::Bid, 1001, 5);    // Executes
+    publisher.publish(orderBook);
+    auto id = orderBook.addOrder(Order::Type::Ask, 1000, 7);
+    publisher.publish(orderBook);
+    orderBook.cancelOrder(id);
+    publisher.publish(orderBook);
+
+    MarketDataEvent event;
+    while (reader.poll(event) == MarketDataReader::PollStatus::Event)
+        readerBook.apply(event);
+    readerBook.expectEqual(orderBook, 3);
+    ASSERT_EQ( event.sequence, publisher.getSequence() );
+
+    /// Nothing changed, nothing published
+    publisher.publish(orderBook);
+    ASSERT_EQ( reader.poll(event), MarketDataReader::PollStatus::Empty );
+}
+
+TEST(MarketDataRingTests, OverrunResync)  // NOLINT
+{
+    auto name = ringName("overrun");
+    MarketDataPublisher publisher(name, 8, 5, 4);
+    MarketDataReader reader(name);
+
+    OrderBook orderBook;
+    for (Order::PriceType price = 900; price < 1000; ++price)
+    {
+        orderBook.addOrder(Order::Type::Bid, price, 10);
+        orderBook.addOrder(Order::Type::Ask, price + 200, 10);
+        publisher.publish(orderBook);
+    }
+
+    MarketDataEvent event;
+    ASSERT_EQ( reader.poll(event), MarketDataReader::PollStatus::Overrun );
+
+    ReaderBook readerBook;
+    MarketDataSnapshot snapshot;
+    ASSERT_TRUE( reader.readSnapshot(snapshot) );
+    readerBook.apply(snapshot);
+    while (reader.poll(event) == MarketDataReader::PollStatus::Event)
+        readerBook.apply(event);
+    readerBook.expectEqual(orderBook, 5);
+}
+
+TEST(MarketDataRingTests, ReaderOfMissingRing)  // NOLINT
+{
+    ASSERT_THROW( MarketDataReader( ringName("missing") ), std::system_error );
+}
\ No newline at end of file
@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "TestBook.h"
+
+TEST(MassCancelTests, CancelAllOrders)  // NOLINT
+{
+    std::vector<std::vector<Order>> batches;
+    OrderBook orderBook = testOrderBook(nullptr, nullptr,
+                                        [&batches](const std::vector<Order>& orders) { batches.push_back(orders); });
+    ASSERT_EQ( orderBook.cancelAllOrders(), 10 );
+    ASSERT_EQ( batches.size(),    1  );
+    ASSERT_EQ( batches[0].size(), 10 );
+    ASSERT_EQ( batches[0][0].getPrice(), 1001 );  // The best ask comes first
+
+    ASSERT_EQ( orderBook.getDepthQuantity(Order::Type::Ask), 0 );
+    ASSERT_EQ( orderBook.getDepthQuantity(Order::Type::Bid), 0 );
+    for (const auto& order : batches[0])
+        ASSERT_FALSE( orderBook.findOrderById( order.getId() ).first );
+
+    /// Book is usable after the storage is cleared
+    auto id = orderBook.addOrder(Order::Type::Bid, 1000, 10);
+    ASSERT_EQ( orderBook.getOrderById(id).getQuantity(), 10 );
+}
+
+TEST(MassCancelTests, CancelSide)  // NOLINT
+{
+    std::vector<Order> canceledOrders;
+    OrderBook orderBook = testOrderBook(nullptr,
+                                        [&canceledOrders](Order order) { canceledOrders.push_back(order); });
+    ASSERT_EQ( orderBook.cancelOrders(Order::Type::Bid), 5 );
+    ASSERT_EQ( canceledOrders.size(), 5 );
+    for (const auto& order : canceledOrders)
+        ASSERT_EQ( order.getType(), Order::Type::Bid );
+
+    ASSERT_EQ( orderBook.getDepthQuantity(Order::Type::Ask), 150 );
+    ASSERT_EQ( orderBook.getDepthQuantity(Order::Type::Bid), 0   );
+    ASSERT_EQ( orderBook.cancelOrders(Order::Type::Bid), 0 );
+}
+
+TEST(MassCancelTests, CancelPriceRange)  // NOLINT
+{
+    std::vector<Order> canceledOrders;
+    OrderBook orderBook = testOrderBook(nullptr,
+                                        [&canceledOrders](Order order) { canceledOrders.push_back(order); });
+    ASSERT_EQ( orderBook.cancelOrders(Order::Type::Ask, 1002, 1010), 3 );
+    ASSERT_EQ( orderBook.cancelOrders(Order::Type::Bid, 850,  999),  4 );
+    ASSERT_EQ( orderBook.cancelOrders(Order::Type::Bid, 801,  850),  0 );
+    ASSERT_EQ( orderBook.cancelOrders(Order::Type::Bid, 900,  800),  0 );
+    ASSERT_EQ( canceledOrders.size(), 7 );
+
+    auto result = R"V({
+    "asks": [
+        {
+            "price": 1001,
+            "quantity": 30
+        }
+    ],
+    "bids": [
+        {
+            "price": 800,
+            "quantity": 55
+        }
+    ]
+}
+)V";
+    ASSERT_STREQ(orderBook.getOrderBookInfoJson().c_str(), result);
+}
\ No newline at end of file
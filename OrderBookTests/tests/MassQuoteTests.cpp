@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+#include "TestBook.h"
+
+static OrderBook::Quote quote(Order::Type         type,
+                              Order::PriceType    price,
+                              Order::QuantityType quantity)
+{
+    OrderBook::Quote result;
+    result.type     = type;
+    result.price    = price;
+    result.quantity = quantity;
+    return result;
+}
+
+TEST(MassQuoteTests, ReusesOrdersAtQuotedPrices)  // NOLINT
+{
+    std::vector<std::vector<Order>> batches;
+    OrderBook orderBook(nullptr, nullptr, [&batches](const std::vector<Order>& orders) { batches.push_back(orders); });
+    std::vector<Order::IdType> ids;
+    auto result = orderBook.massQuote(7, {quote(Order::Type::Bid, 1000, 10),
+                                          quote(Order::Type::Bid,  999, 10),
+                                          quote(Order::Type::Bid,  998, 10),
+                                          quote(Order::Type::Ask, 1002, 10),
+                                          quote(Order::Type::Ask, 1003, 10)}, ids);
+    ASSERT_EQ( result.added, 5 );
+    ASSERT_EQ( ids.size(), 5 );
+    ASSERT_TRUE( batches.empty() );
+    auto firstIds = ids;
+
+    /// Other participant queues behind the quoter at 1000 and 1002
+    auto otherBid = orderBook.addOrder(Order::Type::Bid, 1000, 1);
+    orderBook.addOrder(Order::Type::Ask, 1002, 1);
+
+    result = orderBook.massQuote(7, {quote(Order::Type::Bid, 1000, 10),   // Kept
+                                     quote(Order::Type::Bid,  999,  5),   // Reduced
+                                     quote(Order::Type::Bid,  997, 10),   // Added
+                                     quote(Order::Type::Ask, 1002, 20),   // Increased
+                                     quote(Order::Type::Ask, 1004,  0)}, ids);
+    ASSERT_EQ( result.kept,     1 );
+    ASSERT_EQ( result.amended,  2 );
+    ASSERT_EQ( result.added,    1 );
+    ASSERT_EQ( result.canceled, 2 );
+    ASSERT_EQ( ids[0], firstIds[0] );
+    ASSERT_EQ( ids[1], firstIds[1] );
+    ASSERT_GT( ids[2], otherBid );
+    ASSERT_EQ( ids[3], firstIds[3] );
+    ASSERT_EQ( ids[4], 0 );
+    ASSERT_EQ( batches.size(), 1 );
+    ASSERT_EQ( batches[0].size(), 2 );
+
+    std::vector<OrderBook::QueuedOrder> queued;
+    orderBook.getQueuedOrders(Order::Type::Bid, -1, queued);
+    ASSERT_EQ( queued.size(), 4 );
+    ASSERT_EQ( queued[0].id, firstIds[0] );  // Keeps priority over the other order
+    ASSERT_EQ( queued[2].id,       firstIds[1] );
+    ASSERT_EQ( queued[2].quantity, 5 );
+    orderBook.getQueuedOrders(Order::Type::Ask, -1, queued);
+    ASSERT_EQ( queued.size(), 2 );
+    ASSERT_EQ( queued[1].id,       firstIds[3] );  // Increase loses priority
+    ASSERT_EQ( queued[1].quantity, 20 );
+
+    /// Empty quote pulls all levels
+    result = orderBook.massQuote(7, {}, ids);
+    ASSERT_EQ( result.canceled, 4 );
+    ASSERT_TRUE( ids.empty() );
+    ASSERT_EQ( orderBook.getDepthQuantity(Order::Type::Bid), 1 );
+    ASSERT_EQ( orderBook.getDepthQuantity(Order::Type::Ask), 1 );
+}
+
+TEST(MassQuoteTests, LeavesOnlyQuotedOrders)  // NOLINT
+{
+    std::vector<Order> executedOrders;
+    OrderBook orderBook([&executedOrders](Order order) { executedOrders.push_back(order); });
+
+    std::mt19937 random(13);
+    std::vector<OrderBook::Quote> quotes;
+    std::vector<Order::IdType> ids;
+    std::vector<OrderBook::QueuedOrder> queued;
+    for (int i = 0; i < 500; ++i)
+    {
+        /// Other flow executes against the quotes
+        auto type = random() % 2 ? Order::Type::Bid : Order::Type::Ask;
+        orderBook.addOrder(type, static_cast<Order::PriceType>( 995 + random() % 10 ), 1 + random() % 10, 1);
+
+        /// Quotes around a moving mid price, they may cross the other flow
+        auto mid = static_cast<Order::PriceType>( 998 + random() % 5 );
+        quotes.clear();
+        for (Order::PriceType level = 0; level < 3; ++level)
+        {
+            quotes.push_back( quote(Order::Type::Bid, mid - 1 - level, static_cast<Order::QuantityType>( random() % 5 )) );
+            quotes.push_back( quote(Order::Type::Ask, mid + 1 + level, static_cast<Order::QuantityType>( random() % 5 )) );
+        }
+        orderBook.massQuote(2, quotes, ids);
+
+        size_t restingQuotes = 0;
+        for (size_t j = 0; j < quotes.size(); ++j)
+        {
+            ASSERT_EQ( ids[j] == 0, quotes[j].quantity == 0 );
+            if (ids[j] == 0)
+                continue;
+            auto orderPair = orderBook.findOrderById(ids[j]);
+            if (not orderPair.first)
+                continue;
+            ++restingQuotes;
+            ASSERT_EQ( orderPair.second.getPrice(), quotes[j].price );
+            ASSERT_LE( orderPair.second.getQuantity(), quotes[j].quantity );
+            ASSERT_EQ( orderPair.second.getOwner(), 2 );
+        }
+
+        size_t ownerOrders = 0;
+        for (auto side : {Order::Type::Bid, Order::Type::Ask})
+        {
+            orderBook.getQueuedOrders(side, -1, queued);
+            for (const auto& order : queued)
+                ownerOrders += orderBook.getOrderById(order.id).getOwner() == 2 ? 1 : 0;
+        }
+        ASSERT_EQ( ownerOrders, restingQuotes );
+
+        auto bid = orderBook.getBestPrice(Order::Type::Bid);
+        auto ask = orderBook.getBestPrice(Order::Type::Ask);
+        if (bid.first && ask.first)
+        {
+            ASSERT_LT( bid.second.price, ask.second.price );
+        }
+    }
+    ASSERT_FALSE( executedOrders.empty() );
+}
\ No newline at end of file
@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <MatchingRunner.h>
+
+#include "TestBook.h"
+
+static void submit(MatchingRunner&        runner,
+                   const MatchingCommand& command)
+{
+    while ( not runner.trySubmit(command) )
+        std::this_thread::yield();
+}
+
+TEST(MatchingRunnerTests, MatchesLikeDirectCalls)  // NOLINT
+{
+    MatchingRunner::Options options;
+    options.capacity     = 1000;  // Rounded up to 1024, smaller than the flow, so the producer waits for room
+    options.backoffPolls = 64;
+
+    std::vector<Order::IdType> completedIds;
+    std::vector<Order> executedOrders;
+    uint64_t notApplied = 0;
+    MatchingRunner runner(options,
+                          [&](const MatchingCommand& command, Order::IdType id, bool isApplied)
+                          {
+                              if (command.kind == MatchingCommand::Kind::Add)
+                                  completedIds.push_back(id);
+                              notApplied += isApplied ? 0 : 1;
+                          },
+                          [&executedOrders](Order order) { executedOrders.push_back(order); });
+
+    std::vector<Order> expectedExecutions;
+    OrderBook expectedBook([&expectedExecutions](Order order) { expectedExecutions.push_back(order); });
+    std::vector<Order::IdType> expectedIds;
+    uint64_t expectedNotApplied = 0;
+
+    std::mt19937 random(5);
+    for (int i = 0; i < 5000; ++i)
+    {
+        MatchingCommand command;
+        command.tag = i;
+        auto action = random() % 4;
+        if (action < 2 || expectedIds.empty())
+        {
+            command.kind     = MatchingCommand::Kind::Add;
+            command.type     = random() % 2 ? Order::Type::Bid : Order::Type::Ask;
+            command.price    = static_cast<Order::PriceType>( 1000 + random() % 20 );
+            command.quantity = static_cast<Order::QuantityType>( 1 + random() % 10 );
+            expectedIds.push_back( expectedBook.addOrder(command.type, command.price, command.quantity) );
+        }
+        else if (action == 2)
+        {
+            command.kind = MatchingCommand::Kind::Cancel;
+            command.id   = expectedIds[random() % expectedIds.size()];
+            if (expectedBook.tryCancelOrder(command.id) == OrderBook::CancelStatus::NotFound)
+                ++expectedNotApplied;
+        }
+        else
+        {
+            command.kind     = MatchingCommand::Kind::Amend;
+            command.id       = expectedIds[random() % expectedIds.size()];
+            command.price    = static_cast<Order::PriceType>( 1000 + random() % 20 );
+            command.quantity = static_cast<Order::QuantityType>( 1 + random() % 10 );
+            if (expectedBook.findOrderById(command.id).first)
+                expectedBook.amendOrder(command.id, command.price, command.quantity);
+            else
+                ++expectedNotApplied;
+        }
+        submit(runner, command);
+    }
+    runner.stop();
+
+    ASSERT_EQ( completedIds, expectedIds );
+    ASSERT_EQ( notApplied, expectedNotApplied );
+    ASSERT_EQ( executedOrders.size(), expectedExecutions.size() );
+    ASSERT_EQ( runner.getOrderBook().marketDataL2JsonSnapshot(), expectedBook.marketDataL2JsonSnapshot() );
+
+    auto utilization = runner.getUtilization();
+    ASSERT_EQ( utilization.commands, 5000 );
+    ASSERT_GT( utilization.busyNanoseconds, 0 );
+    ASSERT_GE( utilization.busyFraction(), 0.0 );
+    ASSERT_LE( utilization.busyFraction(), 1.0 );
+}
+
+TEST(MatchingRunnerTests, PinsToCpu)  // NOLINT
+{
+    MatchingRunner::Options options;
+    options.cpu          = 0;
+    options.capacity     = 16;
+    options.backoffPolls = 1;
+    MatchingRunner runner(options);
+#ifdef __linux__
+    ASSERT_TRUE( runner.isPinned() );
+#endif
+
+    MatchingRunner::Options unpinnedOptions;
+    unpinnedOptions.capacity     = 16;
+    unpinnedOptions.backoffPolls = 1;
+    MatchingRunner unpinned(unpinnedOptions);
+    ASSERT_FALSE( unpinned.isPinned() );
+
+    /// Stopped runner is idle and keeps its book readable
+    runner.stop();
+    ASSERT_EQ( runner.getUtilization().commands, 0 );
+    ASSERT_EQ( runner.getOrderBook().getDepthQuantity(Order::Type::Bid), 0 );
+}
+
+TEST(MatchingRunnerTests, ZeroIdIsNotApplied)  // NOLINT
+{
+    MatchingRunner::Options options;
+    options.capacity     = 16;
+    options.backoffPolls = 1;
+    std::vector<bool> applied;
+    MatchingRunner runner(options,
+                          [&applied](const MatchingCommand&, Order::IdType, bool isApplied) { applied.push_back(isApplied); });
+
+    MatchingCommand command;
+    command.kind = MatchingCommand::Kind::Cancel;
+    submit(runner, command);
+    command.kind     = MatchingCommand::Kind::Amend;
+    command.price    = 1000;
+    command.quantity = 1;
+    submit(runner, command);
+    runner.stop();
+
+    ASSERT_EQ( applied, std::vector<bool>({false, false}) );
+}
\ No newline at end of file
@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+#include <new>
+#include <random>
+#include <vector>
+
+#include <MemoryArena.h>
+
+#include "TestBook.h"
+
+TEST(MemoryArenaTests, ReportsBacking)  // NOLINT
+{
+    /// Huge pages and NUMA binding depend on the machine, the arena works either way and tells what it got
+    MemoryArena arena(1000, true, 0);
+    RecordProperty("hugePages", arena.isHugePages() ? "yes" : "no");
+    RecordProperty("numaBound", arena.isNumaBound() ? "yes" : "no");
+    ASSERT_EQ( arena.getCapacity(), MemoryArena::HugePageSize );
+    ASSERT_GE( MemoryArena::currentNumaNode(), 0 );
+
+    MemoryArena plainArena(1000, false);
+    ASSERT_FALSE( plainArena.isHugePages() );
+    ASSERT_FALSE( plainArena.isNumaBound() );
+}
+
+TEST(MemoryArenaTests, ReusesFreedBlocks)  // NOLINT
+{
+    MemoryArena arena(MemoryArena::HugePageSize, false);
+    auto first = arena.allocate(100);
+    ASSERT_EQ( arena.getUsed(), 128 );
+    arena.deallocate(first, 100);
+    ASSERT_EQ( arena.allocate(128), first );
+    ASSERT_NE( arena.allocate(10), first );
+    ASSERT_EQ( arena.getUsed(), 192 );
+
+    ASSERT_THROW( arena.allocate(MemoryArena::HugePageSize), std::bad_alloc );  // NOLINT
+}
+
+TEST(MemoryArenaTests, BookOnArenaMatchesHeapBook)  // NOLINT
+{
+    MemoryArena arena(64 * MemoryArena::HugePageSize);
+    OrderBook arenaBook(nullptr, nullptr, nullptr, &arena);
+    OrderBook heapBook;
+
+    std::mt19937 random(11);
+    std::vector<Order::IdType> ids;
+    for (int i = 0; i < 20000; ++i)
+    {
+        auto type     = random() % 2 ? Order::Type::Bid : Order::Type::Ask;
+        auto price    = static_cast<Order::PriceType>( 1000 + random() % 200 );
+        auto quantity = static_cast<Order::QuantityType>( 1 + random() % 50 );
+        if (random() % 3 == 0 && not ids.empty())
+        {
+            auto id = ids[random() % ids.size()];
+            ASSERT_EQ( arenaBook.tryCancelOrder(id), heapBook.tryCancelOrder(id) );
+        }
+        else
+        {
+            auto id = heapBook.addOrder(type, price, quantity);
+            ASSERT_EQ( arenaBook.addOrder(type, price, quantity), id );
+            ids.push_back(id);
+        }
+    }
+    ASSERT_GT( arena.getUsed(), 0 );
+    ASSERT_EQ( arenaBook.marketDataL2JsonSnapshot(), heapBook.marketDataL2JsonSnapshot() );
+
+    /// Copies live on the heap, copied state stays in the arena of the target
+    auto copy = arenaBook.clone();
+    ASSERT_EQ( copy.marketDataL2JsonSnapshot(), heapBook.marketDataL2JsonSnapshot() );
+    OrderBook scratch(nullptr, nullptr, nullptr, &arena);
+    scratch.copyStateFrom(heapBook);
+    ASSERT_EQ( scratch.marketDataL2JsonSnapshot(), heapBook.marketDataL2JsonSnapshot() );
+}
\ No newline at end of file
@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "TestBook.h"
+
+TEST(OrderBookAmendTests, QuantityDecreaseKeepsPriority)  // NOLINT
+{
+    std::vector<Order> executedOrders;
+    OrderBook orderBook([&executedOrders](Order order) { executedOrders.push_back(order); });
+    auto firstId  = orderBook.addOrder(Order::Type::Ask, 1000, 50);
+    auto secondId = orderBook.addOrder(Order::Type::Ask, 1000, 50);
+    orderBook.amendOrder(firstId, 1000, 20);
+
+    auto order = orderBook.getOrderById(firstId);
+    ASSERT_EQ( order.getPrice(),    1000 );
+    ASSERT_EQ( order.getQuantity(), 20   );
+
+    orderBook.addOrder(Order::Type::Bid, 1000, 10);
+    ASSERT_EQ(executedOrders.size(), 2);
+    ASSERT_EQ( executedOrders[0].getId(),       firstId );
+    ASSERT_EQ( executedOrders[0].getQuantity(), 10      );
+    ASSERT_EQ( orderBook.getOrderById(firstId).getQuantity(),  10 );
+    ASSERT_EQ( orderBook.getOrderById(secondId).getQuantity(), 50 );
+}
+
+TEST(OrderBookAmendTests, QuantityIncreaseLosesPriority)  // NOLINT
+{
+    std::vector<Order> executedOrders;
+    OrderBook orderBook([&executedOrders](Order order) { executedOrders.push_back(order); });
+    auto firstId  = orderBook.addOrder(Order::Type::Bid, 1000, 50);
+    auto secondId = orderBook.addOrder(Order::Type::Bid, 1000, 50);
+    orderBook.amendOrder(firstId, 1000, 60);
+
+    orderBook.addOrder(Order::Type::Ask, 1000, 10);
+    ASSERT_EQ(executedOrders.size(), 2);
+    ASSERT_EQ( executedOrders[0].getId(), secondId );
+    ASSERT_EQ( orderBook.getOrderById(firstId).getQuantity(),  60 );
+    ASSERT_EQ( orderBook.getOrderById(secondId).getQuantity(), 40 );
+}
+
+TEST(OrderBookAmendTests, PriceChange)  // NOLINT
+{
+    OrderBook orderBook = testOrderBook();
+    auto id = orderBook.addOrder(Order::Type::Bid, 950, 100);
+    orderBook.amendOrder(id, 990, 70);
+
+    auto order = orderBook.getOrderById(id);
+    ASSERT_EQ( order.getId(),       id               );
+    ASSERT_EQ( order.getPrice(),    990              );
+    ASSERT_EQ( order.getQuantity(), 70               );
+    ASSERT_EQ( order.getType(),     Order::Type::Bid );
+    auto result = R"V({
+    "asks": [
+        {
+            "price": 1001,
+            "quantity": 30
+        }
+    ],
+    "bids": [
+        {
+            "price": 999,
+            "quantity": 40
+        },
+        {
+            "price": 990,
+            "quantity": 70
+        },
+        {
+            "price": 900,
+            "quantity": 79
+        }
+    ]
+}
+)V";
+    ASSERT_STREQ(orderBook.getOrderBookInfoJson(3, 1).c_str(), result);
+}
+
+TEST(OrderBookAmendTests, PriceChangeExecution)  // NOLINT
+{
+    std::vector<Order> executedOrders;
+    OrderBook orderBook = testOrderBook([&executedOrders](Order order) { executedOrders.push_back(order); });
+    auto id = orderBook.addOrder(Order::Type::Bid, 950, 100);
+    orderBook.amendOrder(id, 1001, 40);
+
+    ASSERT_EQ(executedOrders.size(), 4);
+    ASSERT_EQ( executedOrders[1].getId(),       id );
+    ASSERT_EQ( executedOrders[1].getQuantity(), 20 );
+    ASSERT_EQ( executedOrders[3].getId(),       id );
+    ASSERT_EQ( executedOrders[3].getQuantity(), 10 );
+
+    auto order = orderBook.getOrderById(id);
+    ASSERT_EQ( order.getPrice(),    1001 );
+    ASSERT_EQ( order.getQuantity(), 10   );
+}
+
+TEST(OrderBookAmendTests, FullExecution)  // NOLINT
+{
+    OrderBook orderBook = testOrderBook();
+    auto id = orderBook.addOrder(Order::Type::Ask, 1100, 15);
+    orderBook.amendOrder(id, 999, 15);
+    ASSERT_THROW(orderBook.getOrderById(id), NotFoundException);
+}
+
+TEST(OrderBookAmendTests, ZeroQuantityCancels)  // NOLINT
+{
+    std::vector<Order> canceledOrders;
+    OrderBook orderBook(nullptr,
+                        [&canceledOrders](Order order) { canceledOrders.push_back(order); });
+    auto id = orderBook.addOrder(Order::Type::Ask, 1000, 100);
+    orderBook.amendOrder(id, 1000, 0);
+    ASSERT_EQ(canceledOrders.size(), 1);
+    ASSERT_EQ(canceledOrders[0].getId(), id);
+    ASSERT_THROW(orderBook.getOrderById(id), NotFoundException);
+}
+
+TEST(OrderBookAmendTests, NotFound)  // NOLINT
+{
+    OrderBook orderBook;
+    ASSERT_THROW(orderBook.amendOrder(1, 1000, 100), NotFoundException);
+}
\ No newline at end of file
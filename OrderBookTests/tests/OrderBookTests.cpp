@@ -50,6 +50,35 @@ TEST(OrderBookTests, OrderCancel)  // NOLINT
     }
 }
 
+TEST(OrderBookTests, OrderTryCancel)  // NOLINT
+{
+    std::vector<Order> canceledOrders;
+    OrderBook orderBook(nullptr,
+                        [&canceledOrders](Order order) { canceledOrders.push_back(order); });
+    auto id = orderBook.addOrder(Order::Type::Bid, 1000, 100);
+    ASSERT_EQ( orderBook.tryCancelOrder(id), OrderBook::CancelStatus::Canceled );
+    ASSERT_EQ( orderBook.tryCancelOrder(id), OrderBook::CancelStatus::NotFound );
+    ASSERT_EQ( orderBook.tryCancelOrder(0),  OrderBook::CancelStatus::NotFound );
+    ASSERT_EQ( canceledOrders.size(), 1 );
+    ASSERT_THROW(orderBook.cancelOrder(id), NotFoundException);
+    ASSERT_THROW(orderBook.cancelOrder(0),  NotFoundException);
+}
+
+TEST(OrderBookTests, OrderFindById)  // NOLINT
+{
+    OrderBook orderBook;
+    auto id = orderBook.addOrder(Order::Type::Ask, 1000, 100);
+    auto orderPair = orderBook.findOrderById(id);
+    ASSERT_TRUE(orderPair.first);
+    ASSERT_EQ( orderPair.second.getId(),       id   );
+    ASSERT_EQ( orderPair.second.getPrice(),    1000 );
+    ASSERT_EQ( orderPair.second.getQuantity(), 100  );
+
+    orderBook.cancelOrder(id);
+    ASSERT_FALSE( orderBook.findOrderById(id).first );
+    ASSERT_FALSE( orderBook.findOrderById(0).first );
+}
+
 TEST(OrderBookTests, OrderBookMarketData2)  // NOLINT
 {
     OrderBook orderBook = testOrderBook();
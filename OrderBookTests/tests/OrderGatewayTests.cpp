@@ -0,0 +1,264 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <unistd.h>
+
+#include <OrderGateway.h>
+
+static std::string gatewayPrefix(const char* test)
+{
+    return "/orderbook_gw_" + std::string(test) + '_' + std::to_string( getpid() );
+}
+
+static GatewayRequest addRequest(uint64_t            tag,
+                                 Order::Type         type,
+                                 Order::PriceType    price,
+                                 Order::QuantityType quantity)
+{
+    GatewayRequest request;
+    request.tag      = tag;
+    request.kind     = GatewayRequest::Kind::Add;
+    request.type     = type;
+    request.price    = price;
+    request.quantity = quantity;
+    return request;
+}
+
+TEST(OrderGatewayTests, ExecutionsAreRoutedToOwners)  // NOLINT
+{
+    auto prefix = gatewayPrefix("route");
+    OrderGateway gateway(prefix, 2, 16);
+    OrderGatewayClient seller(prefix, 0);
+    OrderGatewayClient buyer (prefix, 1);
+
+    ASSERT_TRUE( seller.send( addRequest(1, Order::Type::Ask, 1000, 100) ) );
+    ASSERT_EQ( gateway.poll(), 1 );
+    GatewayResponse response;
+    ASSERT_TRUE( seller.poll(response) );
+    ASSERT_EQ( response.kind,     GatewayResponse::Kind::Accepted );
+    ASSERT_EQ( response.tag,      1   );
+    ASSERT_EQ( response.quantity, 100 );
+    auto askId = response.id;
+
+    ASSERT_TRUE( buyer.send( addRequest(7, Order::Type::Bid, 1000, 30) ) );
+    ASSERT_EQ( gateway.poll(), 1 );
+
+    /// Incoming order execution precedes its acceptance
+    ASSERT_TRUE( buyer.poll(response) );
+    ASSERT_EQ( response.kind,     GatewayResponse::Kind::Executed );
+    ASSERT_EQ( response.tag,      7  );
+    ASSERT_EQ( response.quantity, 30 );
+    ASSERT_TRUE( buyer.poll(response) );
+    ASSERT_EQ( response.kind,     GatewayResponse::Kind::Accepted );
+    ASSERT_EQ( response.quantity, 0 );
+    ASSERT_FALSE( buyer.poll(response) );
+
+    /// Passive execution
+    ASSERT_TRUE( seller.poll(response) );
+    ASSERT_EQ( response.kind,     GatewayResponse::Kind::Executed );
+    ASSERT_EQ( response.tag,      0     );
+    ASSERT_EQ( response.id,       askId );
+    ASSERT_EQ( response.price,    1000  );
+    ASSERT_EQ( response.quantity, 30    );
+    ASSERT_EQ( gateway.getOrderBook().getOrderById(askId).getQuantity(), 70 );
+}
+
+TEST(OrderGatewayTests, CancelAndAmend)  // NOLINT
+{
+    auto prefix = gatewayPrefix("cancel");
+    OrderGateway gateway(prefix, 2, 16);
+    OrderGatewayClient owner(prefix, 0);
+    OrderGatewayClient other(prefix, 1);
+
+    owner.send( addRequest(1, Order::Type::Bid, 990, 50) );
+    gateway.poll();
+    GatewayResponse response;
+    owner.poll(response);
+    auto id = response.id;
+
+    GatewayRequest request;
+    request.tag  = 2;
+    request.id   = id;
+    request.kind = GatewayRequest::Kind::Cancel;
+    other.send(request);
+    gateway.poll();
+    ASSERT_TRUE( other.poll(response) );
+    ASSERT_EQ( response.kind,   GatewayResponse::Kind::Rejected         );
+    ASSERT_EQ( response.reason, GatewayResponse::RejectReason::NotOwner );
+
+    request.tag      = 3;
+    request.kind     = GatewayRequest::Kind::Amend;
+    request.price    = 995;
+    request.quantity = 40;
+    owner.send(request);
+    gateway.poll();
+    ASSERT_TRUE( owner.poll(response) );
+    ASSERT_EQ( response.kind,     GatewayResponse::Kind::Amended );
+    ASSERT_EQ( response.tag,      3  );
+    ASSERT_EQ( response.quantity, 40 );
+
+    request.tag  = 4;
+    request.kind = GatewayRequest::Kind::Cancel;
+    owner.send(request);
+    owner.send(request);
+    gateway.poll();
+    ASSERT_TRUE( owner.poll(response) );
+    ASSERT_EQ( response.kind,     GatewayResponse::Kind::Canceled );
+    ASSERT_EQ( response.tag,      4  );
+    ASSERT_EQ( response.quantity, 40 );
+    ASSERT_TRUE( owner.poll(response) );
+    ASSERT_EQ( response.kind,   GatewayResponse::Kind::Rejected             );
+    ASSERT_EQ( response.reason, GatewayResponse::RejectReason::UnknownOrder );
+}
+
+TEST(OrderGatewayTests, MalformedRequestsAreRejected)  // NOLINT
+{
+    auto prefix = gatewayPrefix("malformed");
+    OrderGateway gateway(prefix, 1, 16);
+    OrderGatewayClient client(prefix, 0);
+
+    auto badSide = addRequest(1, static_cast<Order::Type>(7), 1000, 10);
+    GatewayRequest badKind = addRequest(2, Order::Type::Bid, 1000, 10);
+    badKind.kind = static_cast<GatewayRequest::Kind>(9);
+    GatewayRequest noId;
+    noId.tag  = 3;
+    noId.kind = GatewayRequest::Kind::Cancel;
+    GatewayRequest zeroAmend;
+    zeroAmend.tag  = 4;
+    zeroAmend.kind = GatewayRequest::Kind::Amend;
+    zeroAmend.id   = 1;
+    for (const auto& request : {badSide, badKind, noId, zeroAmend})
+        ASSERT_TRUE( client.send(request) );
+    ASSERT_EQ( gateway.poll(), 4 );
+
+    const GatewayResponse::RejectReason expected[] = {GatewayResponse::RejectReason::Malformed,
+                                                      GatewayResponse::RejectReason::Malformed,
+                                                      GatewayResponse::RejectReason::UnknownOrder,
+                                                      GatewayResponse::RejectReason::InvalidQuantity};
+    GatewayResponse response;
+    for (uint64_t tag = 1; tag <= 4; ++tag)
+    {
+        ASSERT_TRUE( client.poll(response) );
+        ASSERT_EQ( response.tag,    tag                             );
+        ASSERT_EQ( response.kind,   GatewayResponse::Kind::Rejected );
+        ASSERT_EQ( response.reason, expected[tag - 1]               );
+    }
+    ASSERT_FALSE( client.poll(response) );
+    ASSERT_EQ( gateway.getOrderBook().getDepthQuantity(Order::Type::Bid), 0 );
+    ASSERT_EQ( gateway.getOrderBook().getDepthQuantity(Order::Type::Ask), 0 );
+}
+
+TEST(OrderGatewayTests, FullResponseQueueKeepsResponses)  // NOLINT
+{
+    auto prefix = gatewayPrefix("full");
+    OrderGateway gateway(prefix, 1, 4);
+    OrderGatewayClient client(prefix, 0);
+
+    for (uint64_t tag = 1; tag <= 4; ++tag)
+        ASSERT_TRUE( client.send( addRequest(tag, Order::Type::Ask, 1000, 1) ) );
+    ASSERT_FALSE( client.send( addRequest(5, Order::Type::Ask, 1000, 1) ) );
+    gateway.poll();
+    client.send( addRequest(5, Order::Type::Bid, 1000, 4) );
+    gateway.poll();  // 4 passive and 4 incoming executions do not fit
+
+    uint64_t received = 0;
+    GatewayResponse response;
+    for (int i = 0; i < 10; ++i)
+    {
+        while ( client.poll(response) )
+            ++received;
+        gateway.poll();
+    }
+    ASSERT_EQ(received, 4 + 8 + 1);
+}
+
+TEST(OrderGatewayTests, SlowConsumerIsBackPressured)  // NOLINT
+{
+    auto prefix = gatewayPrefix("slow");
+    OrderGateway gateway(prefix, 2, 4, 2);
+    OrderGatewayClient slow (prefix, 0);
+    OrderGatewayClient other(prefix, 1);
+
+    for (uint64_t tag = 1; tag <= 8; ++tag)
+    {
+        ASSERT_TRUE( slow.send( addRequest(tag, Order::Type::Bid, 1000, 1) ) );
+        if (tag % 4 == 0)
+        {
+            ASSERT_EQ( gateway.poll(), 4 );
+        }
+    }
+    ASSERT_EQ( gateway.getOrderBook().getDepthQuantity(Order::Type::Bid), 8 );
+
+    /// 4 Accepted responses wait in the gateway, so orders are canceled and requests are not processed
+    ASSERT_TRUE( slow.send( addRequest(9, Order::Type::Bid, 1000, 1) ) );
+    ASSERT_TRUE( other.send( addRequest(10, Order::Type::Ask, 1000, 5) ) );
+    ASSERT_EQ( gateway.poll(), 1 );
+    ASSERT_EQ( gateway.getOrderBook().getDepthQuantity(Order::Type::Bid), 0 );
+    ASSERT_EQ( gateway.getOrderBook().getDepthQuantity(Order::Type::Ask), 5 );
+
+    ASSERT_EQ( gateway.poll(), 0 );
+
+    GatewayResponse response;
+    uint64_t accepted  = 0;
+    uint64_t canceled  = 0;
+    size_t   processed = 0;
+    while (accepted + canceled < 16)
+    {
+        processed += gateway.poll();
+        while ( slow.poll(response) )
+        {
+            accepted += response.kind == GatewayResponse::Kind::Accepted;
+            canceled += response.kind == GatewayResponse::Kind::Canceled;
+        }
+    }
+    ASSERT_EQ(accepted, 8);
+    ASSERT_EQ(canceled, 8);
+
+    /// The poll which sends the rest of the backlog processes the waiting request
+    ASSERT_EQ(processed, 1);
+    gateway.poll();
+    ASSERT_TRUE( slow.poll(response) );
+    ASSERT_EQ( response.kind, GatewayResponse::Kind::Executed );
+    ASSERT_EQ( response.tag,  9 );
+}
+
+TEST(OrderGatewayTests, RoundTripFromClientThread)  // NOLINT
+{
+    auto prefix = gatewayPrefix("latency");
+    OrderGateway gateway(prefix, 1, 64);
+    std::atomic<bool> done(false);
+    std::thread matching([&gateway, &done]()
+    {
+        /// Yielding keeps the test fast on a single core machine
+        while ( not done.load(std::memory_order_relaxed) )
+            if (gateway.poll() == 0)
+                std::this_thread::yield();
+    });
+
+    const int roundTrips = 2000;
+    OrderGatewayClient client(prefix, 0);
+    GatewayResponse response;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < roundTrips; ++i)
+    {
+        /// Bid and ask alternate so that the book stays empty
+        auto type = i % 2 ? Order::Type::Bid : Order::Type::Ask;
+        while ( not client.send( addRequest(i + 1, type, 1000, 1) ) )
+            std::this_thread::yield();
+        do
+        {
+            while ( not client.poll(response) )
+                std::this_thread::yield();
+        }
+        while (response.kind != GatewayResponse::Kind::Accepted);
+        ASSERT_EQ( response.tag, static_cast<uint64_t>(i + 1) );
+    }
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    done = true;
+    matching.join();
+
+    RecordProperty( "RoundTripNanoseconds", std::to_string( static_cast<uint64_t>(elapsed.count() / roundTrips) ) );
+    ASSERT_TRUE( gateway.getOrderBook().getOrderBookInfoJson().find("price") == std::string::npos );
+}
\ No newline at end of file
@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "TestBook.h"
+
+TEST(OrderHandleTests, CancelByHandle)  // NOLINT
+{
+    std::vector<Order> canceledOrders;
+    OrderBook orderBook(nullptr,
+                        [&canceledOrders](Order order) { canceledOrders.push_back(order); });
+    auto handle = orderBook.addOrderWithHandle(Order::Type::Bid, 1000, 100);
+    ASSERT_EQ( orderBook.getOrderById(handle).getId(), handle.id );
+
+    ASSERT_EQ( orderBook.tryCancelOrder(handle), OrderBook::CancelStatus::Canceled );
+    ASSERT_EQ( orderBook.tryCancelOrder(handle), OrderBook::CancelStatus::NotFound );
+    ASSERT_EQ( canceledOrders.size(), 1 );
+    ASSERT_EQ( canceledOrders[0].getId(), handle.id );
+    ASSERT_THROW(orderBook.cancelOrder(handle), NotFoundException);
+    ASSERT_FALSE( orderBook.findOrderById(handle).first );
+}
+
+TEST(OrderHandleTests, StaleHandleOfReusedSlot)  // NOLINT
+{
+    OrderBook orderBook;
+    auto stale = orderBook.addOrderWithHandle(Order::Type::Ask, 1000, 100);
+    orderBook.cancelOrder(stale.id);
+
+    auto fresh = orderBook.addOrderWithHandle(Order::Type::Ask, 1001, 50);
+    ASSERT_EQ( fresh.slot, stale.slot );  // Slot is reused with the new generation
+    ASSERT_NE( fresh.generation, stale.generation );
+    ASSERT_FALSE( orderBook.findOrderById(stale).first );
+    ASSERT_EQ( orderBook.tryCancelOrder(stale), OrderBook::CancelStatus::NotFound );
+    ASSERT_EQ( orderBook.getOrderById(fresh).getQuantity(), 50 );
+}
+
+TEST(OrderHandleTests, ForgedIdIsNotFound)  // NOLINT
+{
+    OrderBook orderBook;
+    auto handle = orderBook.addOrderWithHandle(Order::Type::Ask, 1000, 100);
+    auto forged = handle;
+    forged.id += 1;
+    ASSERT_FALSE( orderBook.findOrderById(forged).first );
+    ASSERT_THROW(orderBook.getOrderById(forged), NotFoundException);
+    ASSERT_EQ( orderBook.tryCancelOrder(forged), OrderBook::CancelStatus::NotFound );
+    ASSERT_EQ( orderBook.getOrderById(handle).getQuantity(), 100 );
+}
+
+TEST(OrderHandleTests, HandleSurvivesAmendAndPartialExecution)  // NOLINT
+{
+    OrderBook orderBook;
+    auto handle = orderBook.addOrderWithHandle(Order::Type::Ask, 1000, 100);
+    orderBook.amendOrder(handle.id, 1002, 80);
+    orderBook.addOrder(Order::Type::Bid, 1002, 30);
+    ASSERT_EQ( orderBook.getOrderById(handle).getQuantity(), 50 );
+
+    orderBook.addOrder(Order::Type::Bid, 1002, 50);
+    ASSERT_FALSE( orderBook.findOrderById(handle).first );
+}
+
+TEST(OrderHandleTests, ExecutedOnAdd)  // NOLINT
+{
+    OrderBook orderBook = testOrderBook();
+    auto handle = orderBook.addOrderWithHandle(Order::Type::Bid, 1001, 10);
+    ASSERT_EQ( handle.slot, OrderPool::InvalidSlot );
+    ASSERT_FALSE( orderBook.findOrderById(handle).first );
+}
+
+TEST(OrderHandleTests, StaleAfterMassCancel)  // NOLINT
+{
+    OrderBook orderBook;
+    auto handle = orderBook.addOrderWithHandle(Order::Type::Ask, 1000, 100);
+    orderBook.cancelAllOrders();
+    auto fresh = orderBook.addOrderWithHandle(Order::Type::Ask, 1000, 100);
+    ASSERT_EQ( fresh.slot, handle.slot );
+    ASSERT_FALSE( orderBook.findOrderById(handle).first );
+    ASSERT_TRUE ( orderBook.findOrderById(fresh).first );
+}
\ No newline at end of file
@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <unordered_map>
+
+#include <OrderIndex.h>
+#include <OrderPool.h>
+
+TEST(OrderStorageTests, CompactLayout)  // NOLINT
+{
+    ASSERT_EQ( sizeof(OrderPool::HotSlot),  8  );
+    ASSERT_EQ( sizeof(OrderPool::ColdSlot), 16 + 2 * sizeof(Order::PriceType) );
+    ASSERT_EQ( sizeof(Order),              16 + 2 * sizeof(Order::PriceType) );
+}
+
+TEST(OrderStorageTests, PoolReusesSlots)  // NOLINT
+{
+    OrderPool pool;
+    Order order(Order::Type::Bid, 1000, 100);
+    auto first  = pool.allocate(order);
+    auto second = pool.allocate(order);
+    ASSERT_NE(first, second);
+    ASSERT_EQ(pool.size(), 2);
+
+    pool.release(first);
+    ASSERT_EQ( pool.allocate(order), first );
+
+    auto restored = pool.restore(second);
+    ASSERT_EQ( restored.getId(),       order.getId()       );
+    ASSERT_EQ( restored.getPrice(),    order.getPrice()    );
+    ASSERT_EQ( restored.getQuantity(), order.getQuantity() );
+    ASSERT_EQ( restored.getType(),     order.getType()     );
+}
+
+TEST(OrderStorageTests, IndexMatchesHashMap)  // NOLINT
+{
+    OrderIndex index;
+    std::unordered_map<Order::IdType, OrderPool::SlotIndex> reference;
+    std::mt19937_64 random(42);
+
+    for (OrderPool::SlotIndex i = 0; i < 100000; ++i)
+    {
+        Order::IdType id = random() % 5000 + 1;
+        if (random() % 2 == 0)
+        {
+            ASSERT_EQ( index.erase(id), reference.erase(id) == 1 );
+        }
+        else if ( reference.find(id) == reference.end() )
+        {
+            index.insert(id, i);
+            reference.emplace(id, i);
+        }
+        ASSERT_EQ( index.size(), reference.size() );
+    }
+
+    for (Order::IdType id = 1; id <= 5000; ++id)
+    {
+        auto it = reference.find(id);
+        ASSERT_EQ( index.find(id), it == reference.end() ? OrderPool::InvalidSlot : it->second );
+    }
+
+    /// ID 0 marks empty entries, it is never found
+    ASSERT_EQ( index.find(0), OrderPool::InvalidSlot );
+    ASSERT_FALSE( index.erase(0) );
+    ASSERT_EQ( index.size(), reference.size() );
+}
\ No newline at end of file
@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "TestBook.h"
+
+TEST(OwnerTests, OrderKeepsOwner)  // NOLINT
+{
+    std::vector<Order> executedOrders;
+    OrderBook orderBook([&executedOrders](Order order) { executedOrders.push_back(order); });
+    auto id = orderBook.addOrder(Order::Type::Ask, 1000, 100, 7);
+    ASSERT_EQ( orderBook.getOrderById(id).getOwner(), 7 );
+
+    orderBook.amendOrder(id, 1001, 50);
+    ASSERT_EQ( orderBook.getOrderById(id).getOwner(), 7 );
+
+    orderBook.addOrder(Order::Type::Bid, 1001, 10, 8);
+    ASSERT_EQ( executedOrders.size(), 2 );
+    ASSERT_EQ( executedOrders[0].getOwner(), 7 );
+    ASSERT_EQ( executedOrders[1].getOwner(), 8 );
+}
+
+TEST(OwnerTests, CancelAllForOwner)  // NOLINT
+{
+    std::vector<Order> canceledOrders;
+    OrderBook orderBook = testOrderBook(nullptr,
+                                        [&canceledOrders](Order order) { canceledOrders.push_back(order); });
+    std::vector<Order::IdType> ownerIds = {
+            orderBook.addOrder(Order::Type::Ask, 1005, 10, 1),
+            orderBook.addOrder(Order::Type::Bid, 990,  20, 1),
+            orderBook.addOrder(Order::Type::Bid, 999,  30, 1)
+    };
+    auto otherId = orderBook.addOrder(Order::Type::Bid, 990, 40, 2);
+
+    /// Fully executed order leaves owner list
+    orderBook.addOrder(Order::Type::Ask, 999, 70);
+    ASSERT_FALSE( orderBook.findOrderById( ownerIds[2] ).first );
+
+    ASSERT_EQ( orderBook.cancelAllForOwner(1), 2 );
+    ASSERT_EQ( canceledOrders.size(), 2 );
+    for (const auto& order : canceledOrders)
+        ASSERT_EQ( order.getOwner(), 1 );
+    ASSERT_FALSE( orderBook.findOrderById( ownerIds[0] ).first );
+    ASSERT_FALSE( orderBook.findOrderById( ownerIds[1] ).first );
+    ASSERT_TRUE ( orderBook.findOrderById( otherId     ).first );
+
+    ASSERT_EQ( orderBook.cancelAllForOwner(1), 0 );
+    ASSERT_EQ( orderBook.getDepthQuantity(Order::Type::Ask), 150 );
+    ASSERT_EQ( orderBook.getDepthQuantity(Order::Type::Bid), 40 + 79 + 55 );
+}
+
+TEST(OwnerTests, OwnerListAfterCancel)  // NOLINT
+{
+    OrderBook orderBook;
+    auto first  = orderBook.addOrder(Order::Type::Ask, 1000, 10, 3);
+    auto second = orderBook.addOrder(Order::Type::Ask, 1001, 10, 3);
+    auto third  = orderBook.addOrder(Order::Type::Ask, 1002, 10, 3);
+    orderBook.cancelOrder(second);
+    orderBook.cancelOrder(third);
+
+    ASSERT_EQ( orderBook.cancelAllForOwner(3), 1 );
+    ASSERT_FALSE( orderBook.findOrderById(first).first );
+}
+
+TEST(OwnerTests, CancelAllForOwnerCancelsStops)  // NOLINT
+{
+    std::vector<Order> canceledOrders;
+    OrderBook orderBook(nullptr,
+                        [&canceledOrders](Order order) { canceledOrders.push_back(order); });
+    auto restingId = orderBook.addOrder(Order::Type::Ask, 1005, 10, 1);
+    auto stopId    = orderBook.addStopOrder(Order::Type::Bid, 1002, 20, 1);
+    auto limitId   = orderBook.addStopLimitOrder(Order::Type::Ask, 995, 994, 30, 1);
+    auto otherId   = orderBook.addStopOrder(Order::Type::Bid, 1002, 40, 2);
+
+    ASSERT_EQ( orderBook.cancelAllForOwner(1), 3 );
+    ASSERT_EQ( canceledOrders.size(), 3 );
+    ASSERT_EQ( canceledOrders[0].getId(), restingId );
+    ASSERT_EQ( canceledOrders[1].getId(), stopId    );
+    ASSERT_EQ( canceledOrders[2].getId(), limitId   );
+    ASSERT_EQ( canceledOrders[2].getPrice(), 994 );
+    for (const auto& order : canceledOrders)
+        ASSERT_EQ( order.getOwner(), 1 );
+
+    ASSERT_EQ( orderBook.tryCancelStopOrder(stopId),  OrderBook::CancelStatus::NotFound );
+    ASSERT_EQ( orderBook.tryCancelStopOrder(limitId), OrderBook::CancelStatus::NotFound );
+    ASSERT_EQ( orderBook.tryCancelStopOrder(otherId), OrderBook::CancelStatus::Canceled );
+    ASSERT_EQ( orderBook.cancelAllForOwner(1), 0 );
+}
\ No newline at end of file
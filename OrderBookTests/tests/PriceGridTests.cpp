@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+#include <limits>
+#include <vector>
+
+#include <PriceGrid.h>
+
+#include "TestBook.h"
+
+/// Prices with two implied decimals, tick 0.05, band [90.00, 110.00]
+using CentGrid = PriceGrid<5, 9000, 11000>;
+
+static_assert( CentGrid::isValid(10005),            "On grid"          );
+static_assert( not CentGrid::isValid(10003),        "Off tick"         );
+static_assert( not CentGrid::isValid(11005),        "Out of band"      );
+static_assert( CentGrid::tickCount == 401,          "Band tick count"  );
+static_assert( CentGrid::tickIndex(9010) == 2,      "Tick index"       );
+static_assert( CentGrid::price<10000>() == 10000,   "Checked constant" );
+
+TEST(PriceGridTests, GridBookRejectsOffGridPrices)  // NOLINT
+{
+    GridOrderBook<CentGrid> orderBook;
+    auto id = orderBook.addOrder( Order::Type::Bid, CentGrid::price<10000>(), 10 );
+
+    ASSERT_THROW( orderBook.addOrder(Order::Type::Bid, 10001, 10), InvalidPriceException );  // NOLINT
+    ASSERT_THROW( orderBook.addOrder(Order::Type::Ask, 8995,  10), InvalidPriceException );  // NOLINT
+    ASSERT_THROW( orderBook.amendOrder(id, 10002, 10),             InvalidPriceException );  // NOLINT
+    ASSERT_THROW( orderBook.addStopLimitOrder(Order::Type::Bid, 10005, 10007, 10), InvalidPriceException );  // NOLINT
+    ASSERT_EQ( orderBook.book().getOrderById(id).getPrice(), 10000 );
+    ASSERT_EQ( orderBook.book().getStopOrderCount(), 0 );
+
+    orderBook.amendOrder(id, 10005, 20);
+    ASSERT_EQ( orderBook.book().getDepthQuantity(Order::Type::Bid), 20 );
+}
+
+TEST(PriceGridTests, GridBookRejectsOffGridQuotes)  // NOLINT
+{
+    GridOrderBook<CentGrid> orderBook;
+    std::vector<OrderBook::Quote> quotes(2);
+    quotes[0].type     = Order::Type::Bid;
+    quotes[0].price    = 9995;
+    quotes[0].quantity = 10;
+    quotes[1].type     = Order::Type::Ask;
+    quotes[1].price    = 10003;
+    quotes[1].quantity = 10;
+    std::vector<Order::IdType> ids;
+
+    /// Nothing is quoted in case one level is off the grid
+    ASSERT_THROW( orderBook.massQuote(1, quotes, ids), InvalidPriceException );  // NOLINT
+    ASSERT_EQ( orderBook.book().getDepthQuantity(Order::Type::Bid), 0 );
+
+    quotes[1].price = 10005;
+    auto result = orderBook.massQuote(1, quotes, ids);
+    ASSERT_EQ( result.added, 2 );
+    ASSERT_EQ( orderBook.cancelAllForOwner(1), 2 );
+}
+
+TEST(PriceGridTests, LevelTotalsDoNotOverflow)  // NOLINT
+{
+    const Order::QuantityType maxQuantity = std::numeric_limits<Order::QuantityType>::max();
+    OrderBook orderBook;
+    orderBook.addOrder(Order::Type::Ask, 1000, maxQuantity);
+    orderBook.addOrder(Order::Type::Ask, 1000, maxQuantity);
+    orderBook.addOrder(Order::Type::Ask, 1001, maxQuantity);
+
+    const uint64_t levelTotal = 2 * uint64_t(maxQuantity);
+    std::vector<OrderBook::PricePosition> levels;
+    orderBook.getPriceLevels(Order::Type::Ask, -1, levels);
+    ASSERT_EQ( levels.size(), 2 );
+    ASSERT_EQ( levels[0].quantity, levelTotal );
+    ASSERT_EQ( orderBook.getDepthQuantity(Order::Type::Ask), levelTotal + maxQuantity );
+
+    /// Trades at one price are summed in the last transaction
+    orderBook.addOrder(Order::Type::Bid, 1000, maxQuantity);
+    orderBook.addOrder(Order::Type::Bid, 1000, maxQuantity);
+    ASSERT_EQ( orderBook.getLastTransaction().second.quantity, levelTotal );
+}
\ No newline at end of file
@@ -0,0 +1,209 @@
+#include "ReferenceBook.h"
+
+#include <algorithm>
+#include <sstream>
+
+template <typename Levels>
+void ReferenceBook::match(RestingOrder& order,
+                          Levels&       levels)
+{
+    while ( order.quantity > 0 && not levels.empty() )
+    {
+        auto levelIt = levels.begin();
+        auto price = levelIt->first;
+        if ( order.type == Order::Type::Bid ? price > order.price : price < order.price )
+            break;
+
+        auto& queue = levelIt->second;
+        while ( order.quantity > 0 && not queue.empty() )
+        {
+            auto& resting = queue.front();
+            auto quantity = std::min(resting.quantity, order.quantity);
+            _events.push_back( Event{true, resting.id, resting.type, price, quantity} );
+            _events.push_back( Event{true, order.id,   order.type,   price, quantity} );
+            resting.quantity -= quantity;
+            order.quantity   -= quantity;
+
+            if (_haveTransactionsStarted && _lastPrice == price)
+                _lastQuantity += quantity;
+            else
+                _lastQuantity = quantity;
+            _lastPrice = price;
+            _haveTransactionsStarted = true;
+
+            if (resting.quantity == 0)
+            {
+                _orders.erase(resting.id);
+                queue.pop_front();
+            }
+        }
+        if ( queue.empty() )
+            levels.erase(levelIt);
+    }
+}
+
+void ReferenceBook::rest(const RestingOrder& order)
+{
+    if (order.type == Order::Type::Bid)
+        _bids[order.price].push_back(order);
+    else
+        _asks[order.price].push_back(order);
+    _orders[order.id] = order;
+}
+
+ReferenceBook::RestingOrder ReferenceBook::remove(Order::IdType id)
+{
+    auto order = _orders.at(id);
+    _orders.erase(id);
+
+    auto eraseFrom = [&order](auto& levels)
+    {
+        auto levelIt = levels.find(order.price);
+        auto& queue = levelIt->second;
+        auto it = std::find_if(queue.begin(), queue.end(),
+                               [&order](const RestingOrder& resting) { return resting.id == order.id; });
+        order = *it;
+        queue.erase(it);
+        if ( queue.empty() )
+            levels.erase(levelIt);
+    };
+    if (order.type == Order::Type::Bid)
+        eraseFrom(_bids);
+    else
+        eraseFrom(_asks);
+    return order;
+}
+
+void ReferenceBook::addOrder(Order::IdType       id,
+                             Order::Type         type,
+                             Order::PriceType    price,
+                             Order::QuantityType quantity)
+{
+    RestingOrder order{id, type, price, quantity};
+    if (type == Order::Type::Bid)
+        match(order, _asks);
+    else
+        match(order, _bids);
+    if (order.quantity > 0)
+        rest(order);
+}
+
+bool ReferenceBook::cancelOrder(Order::IdType id)
+{
+    if ( _orders.find(id) == _orders.end() )
+        return false;
+    auto order = remove(id);
+    _events.push_back( Event{false, order.id, order.type, order.price, order.quantity} );
+    return true;
+}
+
+bool ReferenceBook::amendOrder(Order::IdType       id,
+                               Order::PriceType    newPrice,
+                               Order::QuantityType newQuantity)
+{
+    if ( _orders.find(id) == _orders.end() )
+        return false;
+    if (newQuantity == 0)
+        return cancelOrder(id);
+
+    auto current = findOrderById(id).second;
+    if (current.price == newPrice && newQuantity <= current.quantity)
+    {
+        auto reduce = [&](auto& levels)
+        {
+            for (auto& resting : levels[newPrice])
+                if (resting.id == id)
+                    resting.quantity = newQuantity;
+        };
+        if (current.type == Order::Type::Bid)
+            reduce(_bids);
+        else
+            reduce(_asks);
+        return true;
+    }
+
+    auto order = remove(id);
+    order.price    = newPrice;
+    order.quantity = newQuantity;
+    if (order.type == Order::Type::Bid)
+        match(order, _asks);
+    else
+        match(order, _bids);
+    if (order.quantity > 0)
+        rest(order);
+    return true;
+}
+
+std::pair<bool, ReferenceBook::RestingOrder> ReferenceBook::findOrderById(Order::IdType id) const
+{
+    auto it = _orders.find(id);
+    if ( it == _orders.end() )
+        return std::make_pair( false, RestingOrder{} );
+
+    /// Resting quantity is kept in the queue only
+    const auto& location = it->second;
+    const auto& queue = location.type == Order::Type::Bid ? _bids.at(location.price) : _asks.at(location.price);
+    for (const auto& order : queue)
+        if (order.id == id)
+            return std::make_pair(true, order);
+    return std::make_pair( false, RestingOrder{} );
+}
+
+template <typename Levels>
+static void outputLevelsJson(std::ostream& outStr,
+                             const Levels& levels)
+{
+    bool nextIteration = false;
+    for (const auto& level : levels)
+    {
+        Order::QuantityType quantity = 0;
+        for (const auto& order : level.second)
+            quantity += order.quantity;
+        if (nextIteration)
+            outStr << ",\n";
+        outStr << "        {\n            \"price\": " << level.first
+               << ",\n            \"quantity\": " << quantity << "\n        }";
+        nextIteration = true;
+    }
+}
+
+template <typename Levels>
+static void outputBestJson(std::ostream& outStr,
+                           const char*   name,
+                           const Levels& levels)
+{
+    Order::QuantityType quantity = 0;
+    for (const auto& order : levels.begin()->second)
+        quantity += order.quantity;
+    outStr << "\n    \"" << name << "\": {\n        \"price\": " << levels.begin()->first
+           << ",\n        \"quantity\": " << quantity << "\n    }";
+}
+
+std::string ReferenceBook::marketDataL2JsonSnapshot() const
+{
+    std::ostringstream outStr;
+    outStr << '{';
+
+    /// L1 part reproduces OrderBook comma placement
+    if ( not _asks.empty() )
+        outputBestJson(outStr, "best_ask", _asks);
+    if ( not _asks.empty() && not _bids.empty() )
+        outStr << ',';
+    if ( not _bids.empty() )
+        outputBestJson(outStr, "best_bid", _bids);
+    if (_haveTransactionsStarted)
+    {
+        if ( not _asks.empty() )
+            outStr << ',';
+        outStr << "\n    \"last_transaction\": {\n        \"price\": " << _lastPrice
+               << ",\n        \"quantity\": " << _lastQuantity << "\n    }";
+    }
+    outStr << ",\n";
+
+    outStr << "    \"asks\": [\n";
+    outputLevelsJson(outStr, _asks);
+    outStr << "\n    ],\n    \"bids\": [\n";
+    outputLevelsJson(outStr, _bids);
+    outStr << "\n    ]\n}\n";
+    return outStr.str();
+}
\ No newline at end of file
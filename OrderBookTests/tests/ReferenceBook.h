@@ -0,0 +1,91 @@
+#pragma once
+
+#include <list>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <OrderBook.h>
+
+/**
+ *  @brief Straightforward order book used as the reference of OrderBook semantics
+ *
+ *  @details Orders are kept in std::list queues of std::map price levels, IDs are assigned by the caller.
+ *           Executed and canceled orders are recorded as events.
+ */
+class ReferenceBook
+{
+public:
+    struct Event
+    {
+        bool                executed;  ///< false for canceled order
+        Order::IdType       id;
+        Order::Type         type;
+        Order::PriceType    price;
+        Order::QuantityType quantity;
+
+        bool operator ==(const Event& other) const
+        {
+            return executed == other.executed && id == other.id && type == other.type &&
+                   price == other.price && quantity == other.quantity;
+        }
+    };
+
+    struct RestingOrder
+    {
+        Order::IdType       id;
+        Order::Type         type;
+        Order::PriceType    price;
+        Order::QuantityType quantity;
+    };
+
+    void addOrder(Order::IdType       id,
+                  Order::Type         type,
+                  Order::PriceType    price,
+                  Order::QuantityType quantity);
+
+    /**
+     *  @return false in case the order cannot be found
+     */
+    bool cancelOrder(Order::IdType id);
+
+    /**
+     *  @return false in case the order cannot be found
+     */
+    bool amendOrder(Order::IdType       id,
+                    Order::PriceType    newPrice,
+                    Order::QuantityType newQuantity);
+
+    std::pair<bool, RestingOrder> findOrderById(Order::IdType id) const;
+
+    /**
+     *  @brief Same format as OrderBook::marketDataL2JsonSnapshot
+     */
+    std::string marketDataL2JsonSnapshot() const;
+
+    std::vector<Event>& events() { return _events; }
+
+private:
+    using Queue = std::list<RestingOrder>;
+
+    std::map<Order::PriceType, Queue, std::less<Order::PriceType>>    _asks;
+    std::map<Order::PriceType, Queue, std::greater<Order::PriceType>> _bids;
+    std::unordered_map<Order::IdType, RestingOrder>                   _orders;  ///< Type and price locating resting orders
+    std::vector<Event>                                                _events;
+
+    bool                _haveTransactionsStarted = false;
+    Order::PriceType    _lastPrice               = 0;
+    Order::QuantityType _lastQuantity            = 0;
+
+    template <typename Levels>
+    void match(RestingOrder& order,
+               Levels&       levels);
+
+    void rest(const RestingOrder& order);
+
+    /**
+     *  @brief Remove order from its queue, the order must exist
+     */
+    RestingOrder remove(Order::IdType id);
+};
\ No newline at end of file
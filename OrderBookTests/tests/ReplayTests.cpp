@@ -0,0 +1,199 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+#include <EventFile.h>
+#include <Replayer.h>
+
+static std::string eventFilePath(const char* test)
+{
+    return "/tmp/orderbook_events_" + std::string(test) + '_' + std::to_string( getpid() );
+}
+
+static const char* const Scenario = R"V(# timestamp,action,id,side,price,quantity
+1000,A,11,S,1001,30
+1100,A,12,S,1002,20
+1200,A,13,B,999,40
+1300,M,13,,1000,40
+1400,A,14,B,1001,10
+1500,C,12
+1600,C,99
+)V";
+
+TEST(ReplayTests, ConvertAndReplay)  // NOLINT
+{
+    auto path = eventFilePath("replay");
+    {
+        std::istringstream input(Scenario);
+        EventFileWriter writer(path);
+        ASSERT_EQ( convertCsv(input, writer), 7 );
+    }
+
+    EventFile events(path);
+    ASSERT_EQ( events.size(), 7 );
+    ASSERT_EQ( events.begin()[3].kind,  ReplayEvent::Kind::Amend );
+    ASSERT_EQ( events.begin()[3].price, 1000 );
+
+    OrderBook book;
+    Replayer replayer(book);
+    auto stats = replayer.replay( events.begin(), events.end() );
+    ASSERT_EQ( stats.events,  7 );
+    ASSERT_EQ( stats.skipped, 1 );  // Unknown order 99
+
+    OrderBook expected;
+    expected.addOrder(Order::Type::Ask, 1001, 30);
+    expected.addOrder(Order::Type::Bid, 1000, 40);
+    expected.addOrder(Order::Type::Bid, 1001, 10);  // Executes and sets the last transaction
+    ASSERT_EQ( book.marketDataL2JsonSnapshot(), expected.marketDataL2JsonSnapshot() );
+    ASSERT_EQ( depthChecksum(book), depthChecksum(expected) );
+    std::remove( path.c_str() );
+}
+
+TEST(ReplayTests, RecordedPace)  // NOLINT
+{
+    auto path = eventFilePath("pace");
+    {
+        std::istringstream input("0,A,1,B,1000,1\n20000000,A,2,B,1000,1\n");
+        EventFileWriter writer(path);
+        convertCsv(input, writer);
+    }
+    EventFile events(path);
+    OrderBook book;
+    Replayer replayer(book);
+    auto stats = replayer.replay(events.begin(), events.end(), 2);
+    ASSERT_GE( stats.seconds, 0.009 );
+    std::remove( path.c_str() );
+}
+
+TEST(ReplayTests, TimestampsGoingBack)  // NOLINT
+{
+    auto path = eventFilePath("backwards");
+    {
+        std::istringstream input("5000000,A,1,B,1000,1\n1000000,A,2,S,1001,1\n0,A,3,S,1000,1\n10000000,C,2\n");
+        EventFileWriter writer(path);
+        convertCsv(input, writer);
+    }
+    EventFile events(path);
+    OrderBook book;
+    Replayer replayer(book);
+    auto stats = replayer.replay(events.begin(), events.end(), 1);
+    ASSERT_EQ( stats.events,  4 );
+    ASSERT_EQ( stats.skipped, 0 );
+    ASSERT_GE( stats.seconds, 0.004 );  // Paced by the last event only
+    ASSERT_LT( stats.seconds, 1.0 );
+    ASSERT_EQ( book.getDepthQuantity(Order::Type::Bid), 0 );
+    ASSERT_EQ( book.getDepthQuantity(Order::Type::Ask), 0 );
+    std::remove( path.c_str() );
+}
+
+TEST(ReplayTests, ExecutedOrdersAreUnmapped)  // NOLINT
+{
+    /// Every resting bid is executed by the next ask, the flow never refers to the bids again
+    std::vector<ReplayEvent> events;
+    for (uint64_t id = 1; id <= 20000; ++id)
+    {
+        ReplayEvent event{};
+        event.id       = id;
+        event.price    = 1000;
+        event.quantity = 1;
+        event.type     = id % 2 == 1 ? Order::Type::Bid : Order::Type::Ask;
+        events.push_back(event);
+    }
+    OrderBook book;
+    Replayer replayer(book);
+    auto stats = replayer.replay( events.data(), events.data() + events.size() );
+    ASSERT_EQ( stats.skipped, 0 );
+    ASSERT_LT( replayer.getMappedCount(), 1024 );
+
+    ReplayEvent cancel{};
+    cancel.kind = ReplayEvent::Kind::Cancel;
+    cancel.id   = 19999;
+    ASSERT_EQ( replayer.replay(&cancel, &cancel + 1).skipped, 1 );
+}
+
+TEST(ReplayTests, CsvErrors)  // NOLINT
+{
+    auto path = eventFilePath("errors");
+    EventFileWriter writer(path);
+    std::istringstream badSide("1,A,1,X,1000,1\n");
+    ASSERT_THROW(convertCsv(badSide, writer), std::runtime_error);
+    std::istringstream badNumber("\n1,A,1,B,1000,1x\n");
+    try
+    {
+        convertCsv(badNumber, writer);
+        FAIL();
+    }
+    catch (const std::runtime_error& error)
+    {
+        ASSERT_EQ( std::string( error.what() ).find("line 2"), 0 );
+    }
+    for (const char* line : {"1,A,1,B,1000,-1", "1,A,1,B,1000,4294967296", "1,A,1,B,99999999999999999999,1",
+                             "-1,C,1", "1,C,99999999999999999999"})
+    {
+        std::istringstream outOfRange( "\n\n" + std::string(line) + '\n' );
+        try
+        {
+            convertCsv(outOfRange, writer);
+            FAIL() << line;
+        }
+        catch (const std::runtime_error& error)
+        {
+            ASSERT_EQ( std::string( error.what() ).find("line 3"), 0 ) << error.what();
+        }
+    }
+    writer.close();
+    std::remove( path.c_str() );
+}
+
+TEST(ReplayTests, InvalidEventsAreSkipped)  // NOLINT
+{
+    ReplayEvent events[3] = {};
+    events[0].kind     = static_cast<ReplayEvent::Kind>(7);
+    events[1].type     = static_cast<Order::Type>(2);
+    events[1].price    = 1000;
+    events[1].quantity = 1;
+    events[2].price    = 1000;
+    events[2].quantity = 1;
+    ASSERT_FALSE( isValid(events[0]) );
+    ASSERT_FALSE( isValid(events[1]) );
+    ASSERT_TRUE ( isValid(events[2]) );
+
+    OrderBook book;
+    Replayer replayer(book);
+    ASSERT_EQ( replayer.replay(events, events + 3).skipped, 2 );
+    ASSERT_EQ( book.getDepthQuantity(Order::Type::Ask), 1 );
+}
+
+TEST(ReplayTests, OverflowingEventCount)  // NOLINT
+{
+    auto path = eventFilePath("overflow");
+    {
+        EventFileWriter writer(path);
+        writer.write( ReplayEvent{} );
+    }
+    {
+        /// The event count is at offset 16 of the header, multiplied by the event size it wraps around to 0
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        uint64_t size = uint64_t(1) << 59;
+        file.seekp(16);
+        file.write( reinterpret_cast<const char*>(&size), sizeof(size) );
+    }
+    ASSERT_THROW( EventFile file(path), std::runtime_error );
+    std::remove( path.c_str() );
+}
+
+TEST(ReplayTests, NotAnEventFile)  // NOLINT
+{
+    auto path = eventFilePath("invalid");
+    {
+        std::ofstream file(path);
+        file << "not events";
+    }
+    ASSERT_THROW( EventFile file(path), std::runtime_error );
+    std::remove( path.c_str() );
+}
\ No newline at end of file
@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include <SnapshotArchive.h>
+
+#include "TestBook.h"
+
+static std::string archivePath()
+{
+    return "/tmp/orderbook_archive_" + std::to_string( getpid() ) + ".bin";
+}
+
+static void assertLevels(const std::vector<OrderBook::PricePosition>& actual,
+                         const std::vector<OrderBook::PricePosition>& expected)
+{
+    ASSERT_EQ( actual.size(), expected.size() );
+    for (size_t i = 0; i < actual.size(); ++i)
+    {
+        ASSERT_EQ( actual[i].price,    expected[i].price    );
+        ASSERT_EQ( actual[i].quantity, expected[i].quantity );
+    }
+}
+
+TEST(SnapshotArchiveTests, ReadsAnyTimestamp)  // NOLINT
+{
+    auto path = archivePath();
+    std::vector<ArchivedBook> expected;  // State after every record
+    uint64_t jsonSize = 0;
+    uint64_t archiveSize = 0;
+    {
+        SnapshotArchiveWriter writer(path, 64);
+        OrderBook orderBook;
+        std::mt19937 random(17);
+        std::vector<Order::IdType> ids;
+        uint64_t timestamp = 1000;
+        for (int i = 0; i < 5000; ++i)
+        {
+            auto type = random() % 2 ? Order::Type::Bid : Order::Type::Ask;
+            if (random() % 3 != 0 || ids.empty())
+                ids.push_back( orderBook.addOrder(type, static_cast<Order::PriceType>( 990 + random() % 30 ), 1 + random() % 100) );
+            else
+                orderBook.tryCancelOrder( ids[random() % ids.size()] );
+
+            timestamp += random() % 3;  // Records may share timestamp
+            if ( writer.record(timestamp, orderBook) )
+            {
+                ArchivedBook book;
+                book.timestamp = timestamp;
+                orderBook.getPriceLevels(Order::Type::Bid, -1, book.bids);
+                orderBook.getPriceLevels(Order::Type::Ask, -1, book.asks);
+                if (not expected.empty() && expected.back().timestamp == timestamp)
+                    expected.back() = book;
+                else
+                    expected.push_back(book);
+                jsonSize += orderBook.marketDataL2JsonSnapshot().size();
+            }
+        }
+        ASSERT_FALSE( writer.record(timestamp, orderBook) );  // Nothing changed
+        writer.close();
+        archiveSize = writer.getSize();
+    }
+
+    SnapshotArchive archive(path);
+    ASSERT_FALSE( archive.empty() );
+    ASSERT_EQ( archive.getFirstTimestamp(), expected.front().timestamp );
+    ArchivedBook book;
+    ASSERT_FALSE( archive.readAt(expected.front().timestamp - 1, book) );
+    for (size_t i = 0; i < expected.size(); ++i)
+    {
+        ASSERT_TRUE( archive.readAt(expected[i].timestamp, book) );
+        ASSERT_EQ( book.timestamp, expected[i].timestamp );
+        assertLevels( book.bids, expected[i].bids );
+        assertLevels( book.asks, expected[i].asks );
+    }
+
+    /// Timestamp between records gives the state of the earlier one
+    ASSERT_TRUE( archive.readAt(expected.back().timestamp + 100, book) );
+    assertLevels( book.bids, expected.back().bids );
+
+    /// Keyframes and deltas are a small fraction of full JSON snapshots
+    ASSERT_LT( archiveSize * 10, jsonSize );
+    std::remove( path.c_str() );
+}
+
+TEST(SnapshotArchiveTests, RejectsIncompleteFile)  // NOLINT
+{
+    auto path = archivePath();
+    {
+        SnapshotArchiveWriter writer(path, 4, 2);
+        OrderBook orderBook;
+        orderBook.addOrder(Order::Type::Bid, 1000, 1);
+        orderBook.addOrder(Order::Type::Bid,  999, 1);
+        ASSERT_TRUE( writer.record(1, orderBook) );
+
+        /// The writer is not closed yet
+        ASSERT_THROW( SnapshotArchive archive(path), std::runtime_error );  // NOLINT
+
+        /// Levels beyond the depth are not recorded
+        orderBook.addOrder(Order::Type::Bid, 998, 1);
+        ASSERT_FALSE( writer.record(2, orderBook) );
+        orderBook.addOrder(Order::Type::Bid, 1001, 1);
+        ASSERT_TRUE( writer.record(3, orderBook) );
+    }
+
+    SnapshotArchive archive(path);
+    ArchivedBook book;
+    ASSERT_TRUE( archive.readAt(3, book) );
+    ASSERT_EQ( book.bids.size(), 2 );
+    ASSERT_EQ( book.bids[0].price, 1001 );
+    ASSERT_EQ( book.bids[1].price, 1000 );
+    std::remove( path.c_str() );
+}
\ No newline at end of file
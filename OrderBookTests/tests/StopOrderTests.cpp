@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "TestBook.h"
+
+TEST(StopOrderTests, StopTriggersAsMarketOrder)  // NOLINT
+{
+    std::vector<Order> executedOrders;
+    std::vector<Order> canceledOrders;
+    OrderBook orderBook([&executedOrders](Order order) { executedOrders.push_back(order); },
+                        [&canceledOrders](Order order) { canceledOrders.push_back(order); });
+    orderBook.addOrder(Order::Type::Ask, 1000, 10);
+    orderBook.addOrder(Order::Type::Ask, 1010, 5);
+    orderBook.addOrder(Order::Type::Ask, 1020, 5);
+    auto stop = orderBook.addStopOrder(Order::Type::Bid, 1000, 20);
+    ASSERT_EQ( orderBook.getStopOrderCount(), 1 );
+    ASSERT_TRUE( orderBook.findStopOrderById(stop).first );
+    ASSERT_FALSE( orderBook.findOrderById(stop).first );
+    ASSERT_TRUE( executedOrders.empty() );
+
+    /// Trade at the stop price releases the stop, it sweeps the asks and its rest is canceled
+    orderBook.addOrder(Order::Type::Bid, 1000, 5);
+    ASSERT_EQ( orderBook.getStopOrderCount(), 0 );
+    ASSERT_EQ( executedOrders.size(), 8 );
+    ASSERT_EQ( executedOrders[3].getId(),    stop );
+    ASSERT_EQ( executedOrders[3].getPrice(), 1000 );
+    ASSERT_EQ( executedOrders[7].getId(),    stop );
+    ASSERT_EQ( executedOrders[7].getPrice(), 1020 );
+    ASSERT_EQ( canceledOrders.size(), 1 );
+    ASSERT_EQ( canceledOrders[0].getId(),       stop );
+    ASSERT_EQ( canceledOrders[0].getPrice(),    1000 );
+    ASSERT_EQ( canceledOrders[0].getQuantity(), 5 );
+    ASSERT_EQ( orderBook.getDepthQuantity(Order::Type::Ask), 0 );
+    ASSERT_EQ( orderBook.getLastTransaction().second.price, 1020 );
+}
+
+TEST(StopOrderTests, StopLimitRestsWithItsId)  // NOLINT
+{
+    OrderBook orderBook;
+    orderBook.addOrder(Order::Type::Bid, 1000, 10);
+    orderBook.addOrder(Order::Type::Bid, 990,  10);
+    auto stop = orderBook.addStopLimitOrder(Order::Type::Ask, 1000, 995, 30);
+
+    orderBook.addOrder(Order::Type::Ask, 1000, 10);
+    auto order = orderBook.getOrderById(stop);
+    ASSERT_EQ( order.getType(),     Order::Type::Ask );
+    ASSERT_EQ( order.getPrice(),    995 );
+    ASSERT_EQ( order.getQuantity(), 30 );
+    ASSERT_EQ( orderBook.tryCancelStopOrder(stop), OrderBook::CancelStatus::NotFound );
+    orderBook.cancelOrder(stop);
+}
+
+TEST(StopOrderTests, PendingStopsAreNotTriggeredByOtherPrices)  // NOLINT
+{
+    std::vector<Order> canceledOrders;
+    OrderBook orderBook(nullptr, [&canceledOrders](Order order) { canceledOrders.push_back(order); });
+    orderBook.addOrder(Order::Type::Ask, 1000, 10);
+    orderBook.addOrder(Order::Type::Bid, 990,  10);
+
+    /// Stops already crossed by the last trade wait for the next trade
+    auto bidStop = orderBook.addStopOrder(Order::Type::Bid, 1001, 10, 7);
+    auto askStop = orderBook.addStopLimitOrder(Order::Type::Ask, 989, 985, 10);
+    orderBook.addOrder(Order::Type::Bid, 1000, 5);
+    orderBook.addOrder(Order::Type::Ask, 990,  5);
+    ASSERT_EQ( orderBook.getStopOrderCount(), 2 );
+
+    ASSERT_EQ( orderBook.tryCancelStopOrder(bidStop), OrderBook::CancelStatus::Canceled );
+    ASSERT_EQ( orderBook.tryCancelStopOrder(bidStop), OrderBook::CancelStatus::NotFound );
+    ASSERT_EQ( canceledOrders.size(), 1 );
+    ASSERT_EQ( canceledOrders[0].getId(),    bidStop );
+    ASSERT_EQ( canceledOrders[0].getPrice(), 1001 );
+    ASSERT_EQ( canceledOrders[0].getOwner(), 7 );
+
+    /// Mass cancel keeps pending stops
+    orderBook.cancelAllOrders();
+    ASSERT_TRUE( orderBook.findStopOrderById(askStop).first );
+}
+
+TEST(StopOrderTests, StopsReleaseInPriceTimeOrder)  // NOLINT
+{
+    std::vector<Order> executedOrders;
+    OrderBook orderBook([&executedOrders](Order order) { executedOrders.push_back(order); });
+    orderBook.addOrder(Order::Type::Ask, 1000, 5);
+    orderBook.addOrder(Order::Type::Ask, 1010, 100);
+    auto early  = orderBook.addStopOrder(Order::Type::Bid, 990, 1);
+    auto higher = orderBook.addStopOrder(Order::Type::Bid, 995, 1);
+    auto late   = orderBook.addStopOrder(Order::Type::Bid, 990, 1);
+    auto notTriggered = orderBook.addStopOrder(Order::Type::Bid, 1011, 1);
+
+    orderBook.addOrder(Order::Type::Bid, 1000, 5);
+    std::vector<Order::IdType> stopExecutions;
+    for (size_t i = 2; i < executedOrders.size(); i += 2)
+        stopExecutions.push_back( executedOrders[i + 1].getId() );
+    ASSERT_EQ( stopExecutions, (std::vector<Order::IdType>{early, late, higher}) );
+    ASSERT_TRUE( orderBook.findStopOrderById(notTriggered).first );
+}
+
+TEST(StopOrderTests, SweepTriggersStopsOfPassedPrices)  // NOLINT
+{
+    OrderBook orderBook;
+    orderBook.addOrder(Order::Type::Bid, 1000, 10);
+    orderBook.addOrder(Order::Type::Bid, 990,  10);
+    orderBook.addOrder(Order::Type::Bid, 980,  10);
+    auto stopAt990 = orderBook.addStopLimitOrder(Order::Type::Ask, 990, 1100, 1);
+    auto stopAt985 = orderBook.addStopLimitOrder(Order::Type::Ask, 985, 1100, 1);
+
+    /// The sweep ends at 980, the stop at 990 is triggered by the trade at 990 before it
+    orderBook.addOrder(Order::Type::Ask, 980, 25);
+    ASSERT_TRUE( orderBook.findOrderById(stopAt990).first );
+    ASSERT_TRUE( orderBook.findOrderById(stopAt985).first );
+    ASSERT_EQ( orderBook.getStopOrderCount(), 0 );
+}
+
+TEST(StopOrderTests, StopsCascade)  // NOLINT
+{
+    OrderBook orderBook;
+    orderBook.addOrder(Order::Type::Bid, 1000, 1);
+    orderBook.addOrder(Order::Type::Bid, 990,  1);
+    orderBook.addOrder(Order::Type::Bid, 980,  1);
+    orderBook.addOrder(Order::Type::Bid, 970,  1);
+    orderBook.addStopOrder(Order::Type::Ask, 1000, 1);
+    orderBook.addStopOrder(Order::Type::Ask, 990,  1);
+    orderBook.addStopOrder(Order::Type::Ask, 980,  1);
+
+    /// Every stop executes at the next level and triggers the next stop
+    orderBook.amendOrder( orderBook.addOrder(Order::Type::Ask, 1010, 1), 1000, 1 );
+    ASSERT_EQ( orderBook.getStopOrderCount(), 0 );
+    ASSERT_EQ( orderBook.getDepthQuantity(Order::Type::Bid), 0 );
+    ASSERT_EQ( orderBook.getLastTransaction().second.price, 970 );
+}
+
+TEST(StopOrderTests, UncrossTriggersStops)  // NOLINT
+{
+    OrderBook orderBook;
+    orderBook.startAuction();
+    orderBook.addOrder(Order::Type::Bid, 1000, 10);
+    orderBook.addOrder(Order::Type::Ask, 1000, 10);
+    orderBook.addOrder(Order::Type::Ask, 1005, 10);
+    auto stop = orderBook.addStopLimitOrder(Order::Type::Bid, 1000, 1005, 5);
+
+    orderBook.uncross();
+    ASSERT_FALSE( orderBook.findOrderById(stop).first );
+    ASSERT_EQ( orderBook.getDepthQuantity(Order::Type::Ask), 5 );
+    ASSERT_EQ( orderBook.getLastTransaction().second.price, 1005 );
+}
\ No newline at end of file
@@ -0,0 +1,273 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <vector>
+
+#include "ReferenceBook.h"
+
+/**
+ *  @brief Randomized differential test of OrderBook against ReferenceBook
+ *
+ *  @details Every operation is applied to both books, executions, cancellations, L1/L2 snapshots and
+ *           order lookups are compared after each step. A failing sequence is shrunk to a minimal
+ *           reproduction before it is reported. STRESS_OPERATIONS and STRESS_SEED environment
+ *           variables scale the run, STRESS_SNAPSHOT_INTERVAL thins out the L2 comparison for long soaks,
+ *           e.g. STRESS_OPERATIONS=5000000 STRESS_SNAPSHOT_INTERVAL=1000.
+ */
+
+struct Operation
+{
+    enum class Kind : uint8_t
+    {
+        Add,
+        Cancel,
+        Amend
+    };
+
+    Kind                kind;
+    Order::Type         type;
+    Order::PriceType    price;
+    Order::QuantityType quantity;
+    size_t              target;  ///< Ordinal of the add operation referred by Cancel and Amend
+};
+
+static std::string describe(const Operation& operation)
+{
+    std::ostringstream outStr;
+    switch (operation.kind)
+    {
+        case Operation::Kind::Add:
+            outStr << "add " << (operation.type == Order::Type::Bid ? "bid " : "ask ")
+                   << operation.price << ' ' << operation.quantity;
+            break;
+        case Operation::Kind::Cancel:
+            outStr << "cancel #" << operation.target;
+            break;
+        case Operation::Kind::Amend:
+            outStr << "amend #" << operation.target << ' ' << operation.price << ' ' << operation.quantity;
+            break;
+    }
+    return outStr.str();
+}
+
+static std::vector<Operation> generate(size_t   count,
+                                       uint32_t seed)
+{
+    std::mt19937 random(seed);
+    std::vector<Operation> operations;
+    operations.reserve(count);
+    size_t adds = 0;
+    Order::PriceType mid = 1000;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        /// Mid price random walk keeps both crossing and resting orders
+        if (random() % 64 == 0)
+            mid += static_cast<Order::PriceType>(random() % 5) - 2;
+
+        Operation operation{};
+        auto roll = random() % 100;
+        operation.kind = roll < 55 || adds == 0 ? Operation::Kind::Add
+                       : roll < 80              ? Operation::Kind::Cancel
+                                                : Operation::Kind::Amend;
+        operation.type     = random() % 2 ? Order::Type::Bid : Order::Type::Ask;
+        operation.price    = mid + static_cast<Order::PriceType>(random() % 21) - 10;
+        operation.quantity = 1 + random() % 100;
+        if (operation.kind == Operation::Kind::Amend && random() % 8 == 0)
+            operation.quantity = 0;
+        if (adds > 0)
+        {
+            /// Recent orders are more likely to be still live
+            auto window = std::min<size_t>(adds, 256);
+            operation.target = random() % 4 ? adds - 1 - random() % window : random() % adds;
+        }
+        if (operation.kind == Operation::Kind::Add)
+            ++adds;
+        operations.push_back(operation);
+    }
+    return operations;
+}
+
+static ReferenceBook::Event toEvent(bool         executed,
+                                    const Order& order)
+{
+    return ReferenceBook::Event{executed, order.getId(), order.getType(), order.getPrice(), order.getQuantity()};
+}
+
+/**
+ *  @return Description of the first mismatch, empty string if both books agree
+ */
+static std::string runDifferential(const std::vector<Operation>& operations,
+                                   size_t                        snapshotInterval = 1)
+{
+    std::vector<ReferenceBook::Event> events;
+    OrderBook orderBook([&events](Order order) { events.push_back( toEvent(true,  order) ); },
+                        [&events](Order order) { events.push_back( toEvent(false, order) ); });
+    ReferenceBook referenceBook;
+    std::vector<Order::IdType> ids;
+
+    for (size_t step = 0; step < operations.size(); ++step)
+    {
+        const auto& operation = operations[step];
+        Order::IdType id = 0;
+        switch (operation.kind)
+        {
+            case Operation::Kind::Add:
+                id = orderBook.addOrder(operation.type, operation.price, operation.quantity);
+                referenceBook.addOrder(id, operation.type, operation.price, operation.quantity);
+                ids.push_back(id);
+                break;
+            case Operation::Kind::Cancel:
+                if ( operation.target >= ids.size() )
+                    continue;  // The referred add was shrunk away
+                id = ids[operation.target];
+                if ( (orderBook.tryCancelOrder(id) == OrderBook::CancelStatus::Canceled) !=
+                     referenceBook.cancelOrder(id) )
+                    return "step " + std::to_string(step) + ": cancel result differs";
+                break;
+            case Operation::Kind::Amend:
+            {
+                if ( operation.target >= ids.size() )
+                    continue;
+                id = ids[operation.target];
+                bool found = true;
+                try
+                {
+                    orderBook.amendOrder(id, operation.price, operation.quantity);
+                }
+                catch (const NotFoundException&)
+                {
+                    found = false;
+                }
+                if ( found != referenceBook.amendOrder(id, operation.price, operation.quantity) )
+                    return "step " + std::to_string(step) + ": amend result differs";
+                break;
+            }
+        }
+
+        if ( events != referenceBook.events() )
+            return "step " + std::to_string(step) + ": execution or cancel events differ";
+        events.clear();
+        referenceBook.events().clear();
+
+        auto found    = orderBook    .findOrderById(id);
+        auto expected = referenceBook.findOrderById(id);
+        if ( found.first != expected.first ||
+             ( found.first && ( found.second.getPrice()    != expected.second.price ||
+                                found.second.getQuantity() != expected.second.quantity ||
+                                found.second.getType()     != expected.second.type ) ) )
+            return "step " + std::to_string(step) + ": order lookup differs for ID " + std::to_string(id);
+
+        bool isLastStep = step + 1 == operations.size();
+        if ( (step % snapshotInterval == 0 || isLastStep) &&
+             orderBook.marketDataL2JsonSnapshot() != referenceBook.marketDataL2JsonSnapshot() )
+            return "step " + std::to_string(step) + ": L2 snapshot differs\n" +
+                   orderBook.marketDataL2JsonSnapshot() + "expected\n" + referenceBook.marketDataL2JsonSnapshot();
+    }
+    return std::string();
+}
+
+/**
+ *  @brief Remove chunks of operations while the failure reproduces, halving the chunk size down to one
+ */
+static std::vector<Operation> shrink(std::vector<Operation> operations)
+{
+    for (size_t chunk = operations.size() / 2; chunk > 0; chunk /= 2)
+    {
+        for (size_t begin = 0; begin < operations.size(); )
+        {
+            auto candidate = operations;
+            auto end = std::min(begin + chunk, candidate.size());
+            candidate.erase(candidate.begin() + begin, candidate.begin() + end);
+            if ( not runDifferential(candidate).empty() )
+                operations = std::move(candidate);
+            else
+                begin += chunk;
+        }
+    }
+    return operations;
+}
+
+static size_t environmentValue(const char* name,
+                               size_t      defaultValue)
+{
+    const char* value = std::getenv(name);
+    return value ? std::strtoull(value, nullptr, 10) : defaultValue;
+}
+
+template <typename Function>
+static double operationsPerSecond(size_t   count,
+                                  Function function)
+{
+    auto start = std::chrono::steady_clock::now();
+    function();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return count / std::max(elapsed.count(), 1e-9);
+}
+
+TEST(StressTests, DifferentialAgainstReference)  // NOLINT
+{
+    auto count = environmentValue("STRESS_OPERATIONS", 20000);
+    auto seed  = static_cast<uint32_t>( environmentValue("STRESS_SEED", 20261018) );
+    auto interval = std::max<size_t>( environmentValue("STRESS_SNAPSHOT_INTERVAL", 1), 1 );
+    auto operations = generate(count, seed);
+
+    auto failure = runDifferential(operations, interval);
+    if ( not failure.empty() )
+    {
+        auto minimal = shrink(operations);
+        std::ostringstream outStr;
+        outStr << "seed " << seed << ", " << runDifferential(minimal) << "\nminimal sequence:\n";
+        for (const auto& operation : minimal)
+            outStr << "    " << describe(operation) << '\n';
+        FAIL() << outStr.str();
+    }
+}
+
+TEST(StressTests, Throughput)  // NOLINT
+{
+    auto count = environmentValue("STRESS_OPERATIONS", 20000);
+    auto operations = generate(count, 7);
+
+    auto optimized = operationsPerSecond(count, [&operations]()
+    {
+        OrderBook orderBook;
+        std::vector<Order::IdType> ids;
+        for (const auto& operation : operations)
+        {
+            if (operation.kind == Operation::Kind::Add)
+                ids.push_back( orderBook.addOrder(operation.type, operation.price, operation.quantity) );
+            else if (operation.kind == Operation::Kind::Cancel)
+                orderBook.tryCancelOrder(ids[operation.target]);
+            else if ( orderBook.findOrderById(ids[operation.target]).first )
+                orderBook.amendOrder(ids[operation.target], operation.price, operation.quantity);
+        }
+    });
+    auto reference = operationsPerSecond(count, [&operations]()
+    {
+        ReferenceBook referenceBook;
+        std::vector<Order::IdType> ids;
+        Order::IdType nextId = 1;
+        for (const auto& operation : operations)
+        {
+            if (operation.kind == Operation::Kind::Add)
+            {
+                ids.push_back(nextId);
+                referenceBook.addOrder(nextId++, operation.type, operation.price, operation.quantity);
+            }
+            else if (operation.kind == Operation::Kind::Cancel)
+                referenceBook.cancelOrder(ids[operation.target]);
+            else
+                referenceBook.amendOrder(ids[operation.target], operation.price, operation.quantity);
+            referenceBook.events().clear();
+        }
+    });
+
+    std::cout << "OrderBook: " << static_cast<uint64_t>(optimized) << " ops/s, reference: "
+              << static_cast<uint64_t>(reference) << " ops/s" << std::endl;
+    RecordProperty( "OrderBookOpsPerSecond", std::to_string( static_cast<uint64_t>(optimized) ) );
+    RecordProperty( "ReferenceOpsPerSecond", std::to_string( static_cast<uint64_t>(reference) ) );
+}
\ No newline at end of file
@@ -2,11 +2,13 @@
 
 #include <array>
 
-OrderBook testOrderBook(OrderBook::OrderCallback executedOrderCallback,
-                        OrderBook::OrderCallback canceledOrderCallback)
+OrderBook testOrderBook(OrderBook::OrderCallback      executedOrderCallback,
+                        OrderBook::OrderCallback      canceledOrderCallback,
+                        OrderBook::OrderBatchCallback canceledBatchCallback)
 {
     OrderBook orderBook( std::move(executedOrderCallback),
-                         std::move(canceledOrderCallback) );
+                         std::move(canceledOrderCallback),
+                         std::move(canceledBatchCallback) );
     std::array<Data, 10> orders =
             {
                     Data{Order::Type::Ask, 1003, 50},
@@ -9,5 +9,6 @@ struct Data
     Order::QuantityType quantity;
 };
 
-OrderBook testOrderBook(OrderBook::OrderCallback executedOrderCallback = nullptr,
-                        OrderBook::OrderCallback canceledOrderCallback = nullptr);
\ No newline at end of file
+OrderBook testOrderBook(OrderBook::OrderCallback      executedOrderCallback = nullptr,
+                        OrderBook::OrderCallback      canceledOrderCallback = nullptr,
+                        OrderBook::OrderBatchCallback canceledBatchCallback = nullptr);
\ No newline at end of file
@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include <TopOfBook.h>
+
+#include "TestBook.h"
+
+static std::vector<std::unique_ptr<OrderBook>> randomBooks(size_t count)
+{
+    std::mt19937 random(3);
+    std::vector<std::unique_ptr<OrderBook>> books;
+    for (size_t i = 0; i < count; ++i)
+    {
+        books.push_back( std::unique_ptr<OrderBook>(new OrderBook) );
+        for (int j = 0; j < 5; ++j)
+        {
+            books.back()->addOrder( Order::Type::Bid, static_cast<Order::PriceType>( 990 + random() % 10 ), 1 + random() % 10 );
+            books.back()->addOrder( Order::Type::Ask, static_cast<Order::PriceType>( 1001 + random() % 10 ), 1 + random() % 10 );
+        }
+    }
+    books[count / 2]->cancelOrders(Order::Type::Bid);  // One-sided book
+    return books;
+}
+
+TEST(TopOfBookTests, MatchesBruteForce)  // NOLINT
+{
+    auto books = randomBooks(300);
+    ConsolidatedTop expected;
+    for (size_t i = 0; i < books.size(); ++i)
+    {
+        auto bid = books[i]->getBestPrice(Order::Type::Bid);
+        if ( bid.first && (not expected.hasBid || bid.second.price > expected.bid.price) )
+        {
+            expected.hasBid    = true;
+            expected.bid.price = bid.second.price;
+            expected.bidSource = i;
+        }
+        auto ask = books[i]->getBestPrice(Order::Type::Ask);
+        if ( ask.first && (not expected.hasAsk || ask.second.price < expected.ask.price) )
+        {
+            expected.hasAsk    = true;
+            expected.ask.price = ask.second.price;
+            expected.askSource = i;
+        }
+    }
+    for (const auto& book : books)
+    {
+        auto bid = book->getBestPrice(Order::Type::Bid);
+        auto ask = book->getBestPrice(Order::Type::Ask);
+        if (bid.first && bid.second.price == expected.bid.price)
+        {
+            expected.bid.quantity += bid.second.quantity;
+            ++expected.bidSources;
+        }
+        if (ask.first && ask.second.price == expected.ask.price)
+        {
+            expected.ask.quantity += ask.second.quantity;
+            ++expected.askSources;
+        }
+    }
+
+    /// Single thread and parallel chunks give the same result
+    for (size_t threadCount : {1, 4})
+    {
+        TopOfBookAggregator aggregator(threadCount, 16);
+        for (const auto& book : books)
+            aggregator.addBook(*book);
+        const auto& top = aggregator.refresh();
+        ASSERT_TRUE( top.hasBid );
+        ASSERT_EQ( top.bid.price,    expected.bid.price    );
+        ASSERT_EQ( top.bid.quantity, expected.bid.quantity );
+        ASSERT_EQ( top.bidSource,    expected.bidSource    );
+        ASSERT_EQ( top.bidSources,   expected.bidSources   );
+        ASSERT_EQ( top.ask.price,    expected.ask.price    );
+        ASSERT_EQ( top.ask.quantity, expected.ask.quantity );
+        ASSERT_EQ( top.askSource,    expected.askSource    );
+        ASSERT_EQ( top.askSources,   expected.askSources   );
+
+        const auto& tops = aggregator.getTops();
+        ASSERT_EQ( tops.size(), books.size() );
+        ASSERT_TRUE ( tops[books.size() / 2].isValid );
+        ASSERT_FALSE( tops[books.size() / 2].hasBid  );
+        ASSERT_EQ( tops[0].ask.price, books[0]->getBestPrice(Order::Type::Ask).second.price );
+    }
+}
+
+TEST(TopOfBookTests, ReadsPublishedSnapshots)  // NOLINT
+{
+    auto name = "/orderbook_top_" + std::to_string( getpid() );
+    MarketDataPublisher publisher(name, 64, 2, 1);
+    MarketDataReader reader(name);
+    OrderBook publishedBook;
+    publishedBook.addOrder(Order::Type::Bid, 1002, 7);
+    publishedBook.addOrder(Order::Type::Ask, 1004, 3);
+    publisher.publish(publishedBook);
+
+    OrderBook localBook;
+    localBook.addOrder(Order::Type::Bid, 1002, 5);
+    localBook.addOrder(Order::Type::Ask, 1003, 2);
+
+    TopOfBookAggregator aggregator;
+    aggregator.addBook(localBook);
+    ASSERT_EQ( aggregator.addReader(reader), 1 );
+    const auto& top = aggregator.refresh();
+    ASSERT_EQ( top.bid.price,    1002 );
+    ASSERT_EQ( top.bid.quantity, 12 );
+    ASSERT_EQ( top.bidSources,   2 );
+    ASSERT_EQ( top.ask.price,    1003 );
+    ASSERT_EQ( top.askSource,    0 );
+    ASSERT_EQ( aggregator.getTops()[1].ask.price, 1004 );
+
+    /// Refresh follows both sources
+    publishedBook.addOrder(Order::Type::Ask, 1003, 1);
+    publisher.publish(publishedBook);
+    localBook.cancelOrders(Order::Type::Bid);
+    aggregator.refresh();
+    ASSERT_EQ( aggregator.getConsolidated().ask.price,    1003 );
+    ASSERT_EQ( aggregator.getConsolidated().ask.quantity, 3 );
+    ASSERT_EQ( aggregator.getConsolidated().askSources,   2 );
+    ASSERT_EQ( aggregator.getConsolidated().bidSource,    1 );
+    ASSERT_EQ( aggregator.getConsolidated().bid.quantity, 7 );
+}
\ No newline at end of file
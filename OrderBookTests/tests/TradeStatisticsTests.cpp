@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+
+#include <TradeStatistics.h>
+
+#include "TestBook.h"
+
+TEST(TradeStatisticsTests, SessionStatistics)  // NOLINT
+{
+    OrderBook orderBook = testOrderBook();
+    orderBook.addOrder(Order::Type::Bid, 1002, 45);
+    orderBook.addOrder(Order::Type::Ask, 900, 50);
+
+    const auto& statistics = orderBook.getTradeStatistics();
+    ASSERT_EQ( statistics.open,       1001 );
+    ASSERT_EQ( statistics.high,       1002 );
+    ASSERT_EQ( statistics.low,        900  );
+    ASSERT_EQ( statistics.close,      900  );
+    ASSERT_EQ( statistics.volume,     95   );
+    ASSERT_EQ( statistics.notional,   20 * 1001 + 10 * 1001 + 15 * 1002 + 15 * 999 + 25 * 999 + 10 * 900 );
+    ASSERT_EQ( statistics.tradeCount, 6    );
+    ASSERT_DOUBLE_EQ( statistics.vwap(), statistics.notional / 95. );
+
+    orderBook.resetTradeStatistics();
+    ASSERT_EQ( orderBook.getTradeStatistics().tradeCount, 0 );
+}
+
+TEST(TradeStatisticsTests, RollingStatistics)  // NOLINT
+{
+    RollingTradeStatistics rolling(3);
+    ASSERT_EQ( rolling.get().tradeCount, 0 );
+
+    const Order::PriceType prices[] = { 100, 105, 95, 101, 99, 98 };
+    for (auto price : prices)
+        rolling.update(price, 10);
+
+    auto statistics = rolling.get();
+    ASSERT_EQ( statistics.open,       101 );
+    ASSERT_EQ( statistics.high,       101 );
+    ASSERT_EQ( statistics.low,        98  );
+    ASSERT_EQ( statistics.close,      98  );
+    ASSERT_EQ( statistics.volume,     30  );
+    ASSERT_EQ( statistics.notional,   (101 + 99 + 98) * 10 );
+    ASSERT_EQ( statistics.tradeCount, 3   );
+}
+
+TEST(TradeStatisticsTests, MarketDataL1)  // NOLINT
+{
+    OrderBook orderBook = testOrderBook();
+    orderBook.setStatisticsWindow(2);
+    orderBook.addOrder(Order::Type::Bid, 1002, 45);
+    auto result = R"V({
+    "best_ask": {
+        "price": 1002,
+        "quantity": 15
+    },
+    "best_bid": {
+        "price": 999,
+        "quantity": 40
+    },
+    "last_transaction": {
+        "price": 1002,
+        "quantity": 15
+    },
+    "statistics": {
+        "open": 1001,
+        "high": 1002,
+        "low": 1001,
+        "close": 1002,
+        "volume": 45,
+        "notional": 45060,
+        "vwap": 1001.3333,
+        "trade_count": 3
+    },
+    "rolling_statistics": {
+        "open": 1001,
+        "high": 1002,
+        "low": 1001,
+        "close": 1002,
+        "volume": 25,
+        "notional": 25040,
+        "vwap": 1001.6000,
+        "trade_count": 2
+    }
+}
+)V";
+    ASSERT_STREQ(orderBook.marketDataL1JsonSnapshot(true).c_str(), result);
+}
\ No newline at end of file
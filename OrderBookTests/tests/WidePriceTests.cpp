@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include <EventFile.h>
+#include <PriceGrid.h>
+#include <Replayer.h>
+
+/// Built only into RunWideTests against OrderBookWide
+static_assert(sizeof(Order::PriceType) == 8, "Wide price tests need ORDERBOOK_WIDE_PRICES");
+
+static constexpr Order::PriceType HighPrice = static_cast<Order::PriceType>(INT32_MAX) + 1000;
+
+TEST(WidePriceTests, RestsAndMatchesAboveInt32)  // NOLINT
+{
+    std::vector<Order> executed;
+    OrderBook book( [&executed](Order order){ executed.push_back(order); } );
+    auto bid = book.addOrder(Order::Type::Bid, HighPrice,     30);
+    book.addOrder(Order::Type::Bid, HighPrice - 1, 10);
+    ASSERT_EQ( book.findOrderById(bid).second.getPrice(), HighPrice );
+    ASSERT_EQ( book.getBestPrice(Order::Type::Bid).second.price, HighPrice );
+
+    book.addOrder(Order::Type::Ask, HighPrice - 1, 35);
+    ASSERT_EQ( executed.size(), 4 );
+    ASSERT_EQ( executed[0].getPrice(), HighPrice );
+    ASSERT_EQ( executed[3].getPrice(), HighPrice - 1 );
+    ASSERT_EQ( book.getLastTransaction().second.price, HighPrice - 1 );
+    ASSERT_EQ( book.getBestPrice(Order::Type::Bid).second.quantity, 5 );
+    ASSERT_FALSE( book.getBestPrice(Order::Type::Ask).first );
+}
+
+TEST(WidePriceTests, StopTriggersAboveInt32)  // NOLINT
+{
+    OrderBook book;
+    book.addOrder(Order::Type::Ask, HighPrice,     10);
+    book.addOrder(Order::Type::Ask, HighPrice + 5, 10);
+    auto stop = book.addStopOrder(Order::Type::Bid, HighPrice, 10);
+    book.addOrder(Order::Type::Bid, HighPrice, 10);
+    ASSERT_EQ( book.tryCancelStopOrder(stop), OrderBook::CancelStatus::NotFound );
+    ASSERT_FALSE( book.getBestPrice(Order::Type::Ask).first );
+    ASSERT_EQ( book.getLastTransaction().second.price, HighPrice + 5 );
+}
+
+TEST(WidePriceTests, GridBeyondInt32)  // NOLINT
+{
+    using Grid = PriceGrid<100, HighPrice - 1000 * 100 - 47, HighPrice + 1000 * 100 - 47>;
+    GridOrderBook<Grid> book;
+    ASSERT_EQ( Grid::tickCount, 2001 );
+    book.addOrder(Order::Type::Bid, Grid::minPrice, 10);
+    ASSERT_THROW( book.addOrder(Order::Type::Bid, Grid::minPrice + 1, 10), InvalidPriceException );
+    ASSERT_EQ( book.book().getBestPrice(Order::Type::Bid).second.price, Grid::minPrice );
+}
+
+TEST(WidePriceTests, ReplaysEventFile)  // NOLINT
+{
+    auto path = "/tmp/orderbook_wide_events_" + std::to_string( getpid() );
+    {
+        std::istringstream input( "1000,A,1,B," + std::to_string(HighPrice) + ",10\n"
+                                  "1100,A,2,S," + std::to_string(HighPrice) + ",4\n" );
+        EventFileWriter writer(path);
+        ASSERT_EQ( convertCsv(input, writer), 2 );
+    }
+    EventFile events(path);
+    ASSERT_EQ( events.begin()->price, HighPrice );
+
+    OrderBook book;
+    Replayer replayer(book);
+    replayer.replay( events.begin(), events.end() );
+    ASSERT_EQ( book.getBestPrice(Order::Type::Bid).second.price,    HighPrice );
+    ASSERT_EQ( book.getBestPrice(Order::Type::Bid).second.quantity, 6 );
+    unlink( path.c_str() );
+}
\ No newline at end of file